@@ -0,0 +1,133 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the dense triangular solves used by the GLOP LU factorization. A
+// random upper triangular matrix with --num_cols columns is generated; each
+// column has --entries_per_col non-diagonal entries on rows drawn in the
+// --bandwidth rows above the diagonal. The plain TransposeUpperSolve() is then
+// compared to the level-scheduled TransposeSolveWithLevels() for 1 up to
+// --max_threads threads. The level-scheduled solves need OR-Tools to be built
+// with OMP to use more than one thread.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include "absl/strings/str_format.h"
+#include "ortools/base/commandlineflags.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/timer.h"
+#include "ortools/lp_data/lp_types.h"
+#include "ortools/lp_data/sparse.h"
+#include "ortools/lp_data/sparse_column.h"
+
+ABSL_FLAG(int, num_cols, 200000, "Number of columns of the matrix.");
+ABSL_FLAG(int, entries_per_col, 4,
+          "Number of non-diagonal entries of each column.");
+ABSL_FLAG(int, bandwidth, 20000,
+          "Maximum distance between a non-diagonal entry and the diagonal.");
+ABSL_FLAG(int, num_solves, 50, "Number of solves per measure.");
+ABSL_FLAG(int, max_threads, 8, "Maximum number of threads.");
+ABSL_FLAG(int, seed, 0, "Random seed.");
+
+namespace operations_research {
+namespace glop {
+
+void FillRandomUpperTriangularMatrix(std::mt19937* random,
+                                     TriangularMatrix* matrix) {
+  const int num_cols = absl::GetFlag(FLAGS_num_cols);
+  const int entries_per_col = absl::GetFlag(FLAGS_entries_per_col);
+  const int bandwidth = absl::GetFlag(FLAGS_bandwidth);
+  std::uniform_real_distribution<Fractional> coefficient(-1.0, 1.0);
+  matrix->Reset(RowIndex(num_cols), ColIndex(num_cols));
+  SparseColumn column;
+  for (int col = 0; col < num_cols; ++col) {
+    column.Clear();
+    if (col > 0) {
+      std::uniform_int_distribution<int> row(std::max(0, col - bandwidth),
+                                             col - 1);
+      for (int i = 0; i < entries_per_col; ++i) {
+        column.SetCoefficient(RowIndex(row(*random)),
+                              coefficient(*random) / entries_per_col);
+      }
+      column.CleanUp();
+    }
+    const Fractional diagonal = 1.0 + coefficient(*random);
+    matrix->AddTriangularColumnWithGivenDiagonalEntry(column, RowIndex(col),
+                                                      diagonal);
+  }
+}
+
+void RunBenchmark() {
+  std::mt19937 random(absl::GetFlag(FLAGS_seed));
+  TriangularMatrix matrix;
+  FillRandomUpperTriangularMatrix(&random, &matrix);
+
+  const RowIndex num_rows = matrix.num_rows();
+  DenseColumn rhs(num_rows, 0.0);
+  std::uniform_real_distribution<Fractional> value(-1.0, 1.0);
+  for (RowIndex row(0); row < num_rows; ++row) rhs[row] = value(random);
+
+  const int num_solves = absl::GetFlag(FLAGS_num_solves);
+  DenseColumn expected;
+  WallTimer timer;
+  timer.Start();
+  for (int i = 0; i < num_solves; ++i) {
+    expected = rhs;
+    matrix.TransposeUpperSolve(&expected);
+  }
+  timer.Stop();
+  const double reference_ms = timer.Get() * 1e3 / num_solves;
+  LOG(INFO) << absl::StrFormat("TransposeUpperSolve: %.3f ms per solve.",
+                               reference_ms);
+
+  timer.Restart();
+  matrix.ComputeLevelSchedule();
+  timer.Stop();
+  LOG(INFO) << absl::StrFormat("ComputeLevelSchedule: %d levels in %.3f ms.",
+                               matrix.NumLevels(), timer.Get() * 1e3);
+
+  DenseColumn result;
+  for (int num_threads = 1; num_threads <= absl::GetFlag(FLAGS_max_threads);
+       num_threads *= 2) {
+    timer.Restart();
+    for (int i = 0; i < num_solves; ++i) {
+      result = rhs;
+      matrix.TransposeSolveWithLevels(&result, num_threads);
+    }
+    timer.Stop();
+    Fractional max_difference = 0.0;
+    for (RowIndex row(0); row < num_rows; ++row) {
+      const Fractional scale = std::max(1.0, std::abs(expected[row]));
+      max_difference = std::max(max_difference,
+                                std::abs(result[row] - expected[row]) / scale);
+    }
+    const double ms = timer.Get() * 1e3 / num_solves;
+    LOG(INFO) << absl::StrFormat(
+        "TransposeSolveWithLevels with %d threads: %.3f ms per solve (x%.2f), "
+        "max relative difference %g.",
+        num_threads, ms, reference_ms / ms, max_difference);
+  }
+}
+
+}  // namespace glop
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  absl::SetFlag(&FLAGS_stderrthreshold, 0);
+  operations_research::glop::RunBenchmark();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the running time of GenericMaxFlow when its global update is run
+// on one thread and on --num_threads threads, on two families of randomly
+// generated instances:
+// - grids, where the source is connected to the first column, the last column
+//   is connected to the sink and each cell is connected to its 4 neighbors;
+// - layered graphs, where each node of a layer is connected to
+//   --layered_degree random nodes of the next layer.
+// The optimal flow must not depend on the number of threads.
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ortools/base/commandlineflags.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/timer.h"
+#include "ortools/graph/graph.h"
+#include "ortools/graph/max_flow.h"
+
+ABSL_FLAG(int, num_threads, 4, "Number of threads of the parallel solve.");
+ABSL_FLAG(int, grid_rows, 100, "Number of rows of the grid instance.");
+ABSL_FLAG(int, grid_columns, 100, "Number of columns of the grid instance.");
+ABSL_FLAG(int, layered_num_layers, 20,
+          "Number of layers of the layered instance.");
+ABSL_FLAG(int, layered_width, 4096,
+          "Number of nodes per layer of the layered instance.");
+ABSL_FLAG(int, layered_degree, 4,
+          "Number of arcs from a node to the next layer of the layered "
+          "instance.");
+ABSL_FLAG(int, max_capacity, 100, "Arc capacities are in [1, max_capacity].");
+ABSL_FLAG(int, seed, 0, "Random seed of the instance generation.");
+
+namespace operations_research {
+
+using Graph = ::util::ReverseArcStaticGraph<>;
+
+struct Arc {
+  Graph::NodeIndex tail;
+  Graph::NodeIndex head;
+  FlowQuantity capacity;
+};
+
+struct Instance {
+  Graph::NodeIndex num_nodes = 0;
+  Graph::NodeIndex source = 0;
+  Graph::NodeIndex sink = 0;
+  std::vector<Arc> arcs;
+};
+
+// Nodes are numbered row by row, the source and sink come last.
+Instance GenerateGrid(int rows, int columns, std::mt19937* random) {
+  std::uniform_int_distribution<FlowQuantity> capacity(
+      1, absl::GetFlag(FLAGS_max_capacity));
+  Instance instance;
+  instance.num_nodes = rows * columns + 2;
+  instance.source = rows * columns;
+  instance.sink = rows * columns + 1;
+  const auto cell = [columns](int row, int column) {
+    return row * columns + column;
+  };
+  for (int row = 0; row < rows; ++row) {
+    instance.arcs.push_back(
+        {instance.source, cell(row, 0), capacity(*random)});
+    instance.arcs.push_back(
+        {cell(row, columns - 1), instance.sink, capacity(*random)});
+    for (int column = 0; column < columns; ++column) {
+      if (column + 1 < columns) {
+        instance.arcs.push_back(
+            {cell(row, column), cell(row, column + 1), capacity(*random)});
+        instance.arcs.push_back(
+            {cell(row, column + 1), cell(row, column), capacity(*random)});
+      }
+      if (row + 1 < rows) {
+        instance.arcs.push_back(
+            {cell(row, column), cell(row + 1, column), capacity(*random)});
+        instance.arcs.push_back(
+            {cell(row + 1, column), cell(row, column), capacity(*random)});
+      }
+    }
+  }
+  return instance;
+}
+
+// The source is connected to the first layer and the last layer to the sink.
+Instance GenerateLayered(int num_layers, int width, int degree,
+                         std::mt19937* random) {
+  std::uniform_int_distribution<FlowQuantity> capacity(
+      1, absl::GetFlag(FLAGS_max_capacity));
+  std::uniform_int_distribution<int> position(0, width - 1);
+  Instance instance;
+  instance.num_nodes = num_layers * width + 2;
+  instance.source = num_layers * width;
+  instance.sink = num_layers * width + 1;
+  for (int i = 0; i < width; ++i) {
+    instance.arcs.push_back({instance.source, i, capacity(*random)});
+    instance.arcs.push_back(
+        {(num_layers - 1) * width + i, instance.sink, capacity(*random)});
+  }
+  for (int layer = 0; layer + 1 < num_layers; ++layer) {
+    for (int i = 0; i < width; ++i) {
+      for (int d = 0; d < degree; ++d) {
+        instance.arcs.push_back({layer * width + i,
+                                 (layer + 1) * width + position(*random),
+                                 capacity(*random)});
+      }
+    }
+  }
+  return instance;
+}
+
+// Returns the flow on each arc of the instance.
+std::vector<FlowQuantity> SolveInstance(const Instance& instance,
+                                        int num_threads) {
+  Graph graph(instance.num_nodes, instance.arcs.size());
+  for (const Arc& arc : instance.arcs) {
+    graph.AddArc(arc.tail, arc.head);
+  }
+  std::vector<Graph::ArcIndex> permutation;
+  graph.Build(&permutation);
+
+  WallTimer timer;
+  timer.Start();
+  GenericMaxFlow<Graph> max_flow(&graph, instance.source, instance.sink);
+  for (int i = 0; i < instance.arcs.size(); ++i) {
+    const Graph::ArcIndex arc = permutation.empty() ? i : permutation[i];
+    max_flow.SetArcCapacity(arc, instance.arcs[i].capacity);
+  }
+  max_flow.SetNumThreadsForGlobalUpdate(num_threads);
+  if (!max_flow.Solve()) {
+    LOG(FATAL) << "Solving the max flow failed with status "
+               << static_cast<int>(max_flow.status());
+  }
+  LOG(INFO) << "  " << num_threads << " thread(s): flow "
+            << max_flow.GetOptimalFlow() << " in " << timer.GetInMs()
+            << " ms.";
+  std::vector<FlowQuantity> flows(instance.arcs.size());
+  for (int i = 0; i < instance.arcs.size(); ++i) {
+    flows[i] = max_flow.Flow(permutation.empty() ? i : permutation[i]);
+  }
+  return flows;
+}
+
+void RunBenchmark(const std::string& name, const Instance& instance) {
+  LOG(INFO) << name << ": " << instance.num_nodes << " nodes, "
+            << instance.arcs.size() << " arcs.";
+  const std::vector<FlowQuantity> serial_flows = SolveInstance(instance, 1);
+  const std::vector<FlowQuantity> parallel_flows =
+      SolveInstance(instance, absl::GetFlag(FLAGS_num_threads));
+  for (int i = 0; i < instance.arcs.size(); ++i) {
+    if (serial_flows[i] != parallel_flows[i]) {
+      LOG(FATAL) << "The parallel flow " << parallel_flows[i] << " on arc " << i
+                 << " differs from the serial flow " << serial_flows[i];
+    }
+  }
+}
+
+void RunBenchmarks() {
+  std::mt19937 random(absl::GetFlag(FLAGS_seed));
+  RunBenchmark("Grid", GenerateGrid(absl::GetFlag(FLAGS_grid_rows),
+                                    absl::GetFlag(FLAGS_grid_columns),
+                                    &random));
+  RunBenchmark("Layered",
+               GenerateLayered(absl::GetFlag(FLAGS_layered_num_layers),
+                               absl::GetFlag(FLAGS_layered_width),
+                               absl::GetFlag(FLAGS_layered_degree), &random));
+}
+
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  absl::SetFlag(&FLAGS_stderrthreshold, 0);
+  operations_research::RunBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the cost of the no_overlap_2d propagation on large instances. A
+// strip packing problem with --num_boxes random rectangles is generated, in
+// the spirit of the instances of binpacking_2d_sat.cc but with a single bin
+// that is scaled up with the number of boxes: all boxes must be placed in a
+// strip of width --strip_width (by default the square root of the total area of
+// the boxes) and the height of the strip is minimized.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "google/protobuf/text_format.h"
+#include "ortools/base/commandlineflags.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/timer.h"
+#include "ortools/sat/cp_model.h"
+
+ABSL_FLAG(int, num_boxes, 10000, "Number of boxes to place.");
+ABSL_FLAG(int, max_box_size, 20,
+          "The sizes of the boxes are in [1, max_box_size].");
+ABSL_FLAG(int, strip_width, 0,
+          "Width of the strip. The 0 default value uses the square root of "
+          "the total area of the boxes.");
+ABSL_FLAG(int, seed, 0, "Random seed of the instance generation.");
+ABSL_FLAG(std::string, params, "max_time_in_seconds:60",
+          "Sat parameters in text proto format.");
+
+namespace operations_research {
+namespace sat {
+
+void GenerateAndSolve() {
+  const int num_boxes = absl::GetFlag(FLAGS_num_boxes);
+  std::mt19937 random(absl::GetFlag(FLAGS_seed));
+  std::uniform_int_distribution<int64_t> box_size(
+      1, absl::GetFlag(FLAGS_max_box_size));
+  std::vector<int64_t> widths(num_boxes);
+  std::vector<int64_t> heights(num_boxes);
+  int64_t total_area = 0;
+  int64_t sum_of_heights = 0;
+  int64_t max_width = 0;
+  for (int box = 0; box < num_boxes; ++box) {
+    widths[box] = box_size(random);
+    heights[box] = box_size(random);
+    total_area += widths[box] * heights[box];
+    sum_of_heights += heights[box];
+    max_width = std::max(max_width, widths[box]);
+  }
+  const int64_t strip_width =
+      absl::GetFlag(FLAGS_strip_width) == 0
+          ? std::max<int64_t>(max_width, std::sqrt(total_area))
+          : absl::GetFlag(FLAGS_strip_width);
+  CHECK_GE(strip_width, max_width);
+  const int64_t area_lb = (total_area + strip_width - 1) / strip_width;
+  LOG(INFO) << num_boxes << " boxes with a total area of " << total_area
+            << " in a strip of width " << strip_width
+            << ", trivial lower bound of the height = " << area_lb;
+
+  CpModelBuilder cp_model;
+  const IntVar height = cp_model.NewIntVar({area_lb, sum_of_heights});
+  NoOverlap2DConstraint no_overlap_2d = cp_model.AddNoOverlap2D();
+  for (int box = 0; box < num_boxes; ++box) {
+    const IntVar x = cp_model.NewIntVar({0, strip_width - widths[box]});
+    const IntVar y = cp_model.NewIntVar({0, sum_of_heights - heights[box]});
+    no_overlap_2d.AddRectangle(
+        cp_model.NewFixedSizeIntervalVar(x, widths[box]),
+        cp_model.NewFixedSizeIntervalVar(y, heights[box]));
+    cp_model.AddLessOrEqual(y + heights[box], height);
+  }
+  cp_model.Minimize(height);
+
+  SatParameters parameters;
+  parameters.set_log_search_progress(true);
+  parameters.set_use_timetabling_in_no_overlap_2d(true);
+  parameters.set_use_energetic_reasoning_in_no_overlap_2d(true);
+  if (!absl::GetFlag(FLAGS_params).empty()) {
+    CHECK(google::protobuf::TextFormat::MergeFromString(
+        absl::GetFlag(FLAGS_params), &parameters))
+        << absl::GetFlag(FLAGS_params);
+  }
+
+  WallTimer timer;
+  timer.Start();
+  const CpSolverResponse response =
+      SolveWithParameters(cp_model.Build(), parameters);
+  LOG(INFO) << CpSolverStatus_Name(response.status()) << ": height "
+            << response.objective_value() << ", bound "
+            << response.best_objective_bound() << ", "
+            << response.num_branches() << " branches, "
+            << response.num_conflicts() << " conflicts in "
+            << timer.GetInMs() << " ms.";
+}
+
+}  // namespace sat
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  absl::SetFlag(&FLAGS_stderrthreshold, 0);
+  operations_research::sat::GenerateAndSolve();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the cost of saving values on the trail of the CP solver and of
+// restoring them on backtrack. A complete binary search tree of depth --depth
+// is explored; each branch saves and modifies --values_per_branch random ints,
+// int64s, doubles and pointers, out of --num_values of each type. The search is
+// run once per trail compression setting; all values must be restored to their
+// initial value at the end of the search.
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "ortools/base/commandlineflags.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/timer.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/solver_parameters.pb.h"
+
+ABSL_FLAG(int, depth, 14, "Depth of the complete binary search tree.");
+ABSL_FLAG(int, num_values, 10000, "Number of saved values of each type.");
+ABSL_FLAG(int, values_per_branch, 256,
+          "Number of values of each type modified on each branch.");
+ABSL_FLAG(int, trail_block_size, 8000, "Size of the blocks of the trail.");
+ABSL_FLAG(int, seed, 0, "Random seed.");
+
+namespace operations_research {
+
+struct Values {
+  std::vector<int> ints;
+  std::vector<int64_t> int64s;
+  std::vector<double> doubles;
+  std::vector<void*> pointers;
+};
+
+// Saves and modifies random values, both when applied and when refuted. The
+// random indices are drawn beforehand to only measure the cost of the trail.
+class ModifyValues : public Decision {
+ public:
+  ModifyValues(Values* values, int values_per_branch, std::mt19937* random)
+      : values_(values), values_per_branch_(values_per_branch), next_(0) {
+    constexpr int kNumRandomIndices = 1 << 16;
+    std::uniform_int_distribution<int> index(0, values->ints.size() - 1);
+    indices_.reserve(kNumRandomIndices);
+    for (int i = 0; i < kNumRandomIndices; ++i) {
+      indices_.push_back(index(*random));
+    }
+  }
+
+  void Apply(Solver* const solver) override { Modify(solver); }
+  void Refute(Solver* const solver) override { Modify(solver); }
+  std::string DebugString() const override { return "ModifyValues"; }
+
+ private:
+  void Modify(Solver* const solver) {
+    for (int i = 0; i < values_per_branch_; ++i) {
+      const int index = indices_[next_];
+      next_ = (next_ + 1) % indices_.size();
+      const int value = next_ + 1;
+      solver->SaveAndSetValue(&values_->ints[index], value);
+      solver->SaveAndSetValue(&values_->int64s[index],
+                              static_cast<int64_t>(value) << 32);
+      solver->SaveAndSetValue(&values_->doubles[index],
+                              static_cast<double>(value));
+      solver->SaveAndSetValue(&values_->pointers[index],
+                              static_cast<void*>(&values_->ints[value % 2]));
+    }
+  }
+
+  Values* const values_;
+  const int values_per_branch_;
+  std::vector<int> indices_;
+  int next_;
+};
+
+class ModifyValuesBuilder : public DecisionBuilder {
+ public:
+  ModifyValuesBuilder(Values* values, int depth, int values_per_branch,
+                      std::mt19937* random)
+      : decision_(values, values_per_branch, random), depth_(depth) {}
+
+  Decision* Next(Solver* const solver) override {
+    if (solver->SearchDepth() >= depth_) return nullptr;
+    return &decision_;
+  }
+  std::string DebugString() const override { return "ModifyValuesBuilder"; }
+
+ private:
+  ModifyValues decision_;
+  const int depth_;
+};
+
+void RunBenchmark(ConstraintSolverParameters::TrailCompression compression) {
+  const int num_values = absl::GetFlag(FLAGS_num_values);
+  Values values;
+  values.ints.assign(num_values, 0);
+  values.int64s.assign(num_values, 0);
+  values.doubles.assign(num_values, 0.0);
+  values.pointers.assign(num_values, nullptr);
+
+  ConstraintSolverParameters parameters = Solver::DefaultSolverParameters();
+  parameters.set_compress_trail(compression);
+  parameters.set_trail_block_size(absl::GetFlag(FLAGS_trail_block_size));
+  Solver solver("trail_benchmark", parameters);
+  std::mt19937 random(absl::GetFlag(FLAGS_seed));
+  ModifyValuesBuilder* const builder =
+      solver.RevAlloc(new ModifyValuesBuilder(
+          &values, absl::GetFlag(FLAGS_depth),
+          absl::GetFlag(FLAGS_values_per_branch), &random));
+
+  WallTimer timer;
+  timer.Start();
+  solver.NewSearch(builder);
+  int64_t num_leaves = 0;
+  while (solver.NextSolution()) ++num_leaves;
+  solver.EndSearch();
+  timer.Stop();
+
+  for (int i = 0; i < num_values; ++i) {
+    if (values.ints[i] != 0 || values.int64s[i] != 0 ||
+        values.doubles[i] != 0.0 || values.pointers[i] != nullptr) {
+      LOG(FATAL) << "Value " << i << " was not restored on backtrack.";
+    }
+  }
+  LOG(INFO) << absl::StrFormat(
+      "%s: %d leaves, %d branches in %.1f ms (%.1f ns per saved value).",
+      ConstraintSolverParameters::TrailCompression_Name(compression),
+      num_leaves, solver.branches(), timer.GetInMs(),
+      timer.GetInMs() * 1e6 /
+          (4.0 * solver.branches() * absl::GetFlag(FLAGS_values_per_branch)));
+}
+
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  absl::SetFlag(&FLAGS_stderrthreshold, 0);
+  operations_research::RunBenchmark(
+      operations_research::ConstraintSolverParameters::NO_COMPRESSION);
+  operations_research::RunBenchmark(
+      operations_research::ConstraintSolverParameters::COMPRESS_WITH_ZLIB);
+  return EXIT_SUCCESS;
+}
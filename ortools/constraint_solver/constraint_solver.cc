@@ -62,6 +62,10 @@ ABSL_FLAG(bool, cp_disable_solve, false,
           "Force failure at the beginning of a search.");
 ABSL_FLAG(std::string, cp_profile_file, "",
           "Export profiling overview to file.");
+ABSL_FLAG(std::string, cp_profile_folded_stacks_file, "",
+          "Export profiling data to file in the folded stack format.");
+ABSL_FLAG(int, cp_profile_sampling_period, 1,
+          "Only time one demon run out of this number when profiling.");
 ABSL_FLAG(bool, cp_print_local_search_profile, false,
           "Print local search profiling data after solving.");
 ABSL_FLAG(bool, cp_name_variables, false, "Force all variables to have names.");
@@ -136,11 +140,17 @@ ConstraintSolverParameters Solver::DefaultSolverParameters() {
   params.set_trail_block_size(8000);
   params.set_array_split_size(16);
   params.set_store_names(true);
-  params.set_profile_propagation(!absl::GetFlag(FLAGS_cp_profile_file).empty());
+  params.set_profile_propagation(
+      !absl::GetFlag(FLAGS_cp_profile_file).empty() ||
+      !absl::GetFlag(FLAGS_cp_profile_folded_stacks_file).empty());
   params.set_trace_propagation(absl::GetFlag(FLAGS_cp_trace_propagation));
   params.set_trace_search(absl::GetFlag(FLAGS_cp_trace_search));
   params.set_name_all_variables(absl::GetFlag(FLAGS_cp_name_variables));
   params.set_profile_file(absl::GetFlag(FLAGS_cp_profile_file));
+  params.set_profile_sampling_period(
+      absl::GetFlag(FLAGS_cp_profile_sampling_period));
+  params.set_profile_folded_stacks_file(
+      absl::GetFlag(FLAGS_cp_profile_folded_stacks_file));
   params.set_profile_local_search(
       absl::GetFlag(FLAGS_cp_print_local_search_profile));
   params.set_print_local_search_profile(
@@ -187,7 +197,13 @@ bool Solver::InstrumentsDemons() const {
 
 bool Solver::IsProfilingEnabled() const {
   return parameters_.profile_propagation() ||
-         !parameters_.profile_file().empty();
+         !parameters_.profile_file().empty() ||
+         !parameters_.profile_folded_stacks_file().empty();
+}
+
+int Solver::DemonRunsSamplingPeriod() const {
+  if (!IsProfilingEnabled()) return 1;
+  return std::max(1, parameters_.profile_sampling_period());
 }
 
 bool Solver::IsLocalSearchProfilingEnabled() const {
@@ -470,11 +486,7 @@ struct StateMarker {
 
  private:
   Solver::MarkerType type_;
-  int rev_int_index_;
-  int rev_int64_index_;
-  int rev_uint64_index_;
-  int rev_double_index_;
-  int rev_ptr_index_;
+  int64_t rev_value_index_;
   int rev_boolvar_list_index_;
   int rev_bools_index_;
   int rev_int_memory_index_;
@@ -489,11 +501,7 @@ struct StateMarker {
 
 StateMarker::StateMarker(Solver::MarkerType t, const StateInfo& info)
     : type_(t),
-      rev_int_index_(0),
-      rev_int64_index_(0),
-      rev_uint64_index_(0),
-      rev_double_index_(0),
-      rev_ptr_index_(0),
+      rev_value_index_(0),
       rev_boolvar_list_index_(0),
       rev_bools_index_(0),
       rev_int_memory_index_(0),
@@ -506,20 +514,43 @@ StateMarker::StateMarker(Solver::MarkerType t, const StateInfo& info)
 // ---------- Trail and Reversibility ----------
 
 namespace {
-// ----- addrval struct -----
-
-// This template class is used internally to implement reversibility.
-// It stores an address and the value that was at the address.
-template <class T>
-struct addrval {
+// ----- Trail entry -----
+
+// This class is used internally to implement reversibility.
+// It stores an address and the value that was at the address, for all the
+// types of values saved on the trail (int, int64_t, uint64_t, double and
+// pointers), so that they can share a single trail restored in one pass.
+// The value is stored as raw bytes; whether it is 4 or 8 bytes long is encoded
+// in the lowest bit of the address, which is free as all these types are at
+// least 4-byte aligned.
+class TrailEntry {
  public:
-  addrval() : address_(nullptr) {}
-  explicit addrval(T* adr) : address_(adr), old_value_(*adr) {}
-  void restore() const { (*address_) = old_value_; }
+  TrailEntry() : tagged_address_(0), old_value_(0) {}
+  template <class T>
+  explicit TrailEntry(T* adr)
+      : tagged_address_(reinterpret_cast<uintptr_t>(adr) |
+                        (sizeof(T) == sizeof(uint32_t) ? kFourBytes : 0)),
+        old_value_(0) {
+    static_assert(sizeof(T) == sizeof(uint32_t) ||
+                  sizeof(T) == sizeof(uint64_t));
+    DCHECK_EQ(reinterpret_cast<uintptr_t>(adr) & kFourBytes, 0);
+    memcpy(&old_value_, adr, sizeof(T));
+  }
+  void restore() const {
+    void* const address =
+        reinterpret_cast<void*>(tagged_address_ & ~kFourBytes);
+    if (tagged_address_ & kFourBytes) {
+      memcpy(address, &old_value_, sizeof(uint32_t));
+    } else {
+      memcpy(address, &old_value_, sizeof(uint64_t));
+    }
+  }
 
  private:
-  T* address_;
-  T old_value_;
+  static constexpr uintptr_t kFourBytes = 1;
+
+  uintptr_t tagged_address_;
+  uint64_t old_value_;
 };
 
 // ----- Compressed trail -----
@@ -532,9 +563,9 @@ class TrailPacker {
  public:
   explicit TrailPacker(int block_size) : block_size_(block_size) {}
   virtual ~TrailPacker() {}
-  int input_size() const { return block_size_ * sizeof(addrval<T>); }
-  virtual void Pack(const addrval<T>* block, std::string* packed_block) = 0;
-  virtual void Unpack(const std::string& packed_block, addrval<T>* block) = 0;
+  int input_size() const { return block_size_ * sizeof(T); }
+  virtual void Pack(const T* block, std::string* packed_block) = 0;
+  virtual void Unpack(const std::string& packed_block, T* block) = 0;
 
  private:
   const int block_size_;
@@ -547,14 +578,14 @@ class NoCompressionTrailPacker : public TrailPacker<T> {
   explicit NoCompressionTrailPacker(int block_size)
       : TrailPacker<T>(block_size) {}
   ~NoCompressionTrailPacker() override {}
-  void Pack(const addrval<T>* block, std::string* packed_block) override {
+  void Pack(const T* block, std::string* packed_block) override {
     DCHECK(block != nullptr);
     DCHECK(packed_block != nullptr);
     absl::string_view block_str(reinterpret_cast<const char*>(block),
                                 this->input_size());
     packed_block->assign(block_str.data(), block_str.size());
   }
-  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+  void Unpack(const std::string& packed_block, T* block) override {
     DCHECK(block != nullptr);
     memcpy(block, packed_block.c_str(), packed_block.size());
   }
@@ -573,7 +604,7 @@ class ZlibTrailPacker : public TrailPacker<T> {
 
   ~ZlibTrailPacker() override {}
 
-  void Pack(const addrval<T>* block, std::string* packed_block) override {
+  void Pack(const T* block, std::string* packed_block) override {
     DCHECK(block != nullptr);
     DCHECK(packed_block != nullptr);
     uLongf size = tmp_size_;
@@ -586,7 +617,7 @@ class ZlibTrailPacker : public TrailPacker<T> {
     packed_block->assign(block_str.data(), block_str.size());
   }
 
-  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+  void Unpack(const std::string& packed_block, T* block) override {
     DCHECK(block != nullptr);
     uLongf size = this->input_size();
     const int result =
@@ -611,8 +642,8 @@ class CompressedTrail {
       : block_size_(block_size),
         blocks_(nullptr),
         free_blocks_(nullptr),
-        data_(new addrval<T>[block_size]),
-        buffer_(new addrval<T>[block_size]),
+        data_(new T[block_size]),
+        buffer_(new T[block_size]),
         buffer_used_(false),
         current_(0),
         size_(0) {
@@ -642,14 +673,20 @@ class CompressedTrail {
     FreeBlocks(blocks_);
     FreeBlocks(free_blocks_);
   }
-  const addrval<T>& Back() const {
-    // Back of empty trail.
-    DCHECK_GT(current_, 0);
-    return data_[current_ - 1];
-  }
-  void PopBack() {
-    if (size_ > 0) {
-      --current_;
+  // Restores the elements pushed after the first 'size' ones, from the most
+  // recent to the oldest, and removes them. Elements are restored block by
+  // block, in a single linear scan of each block.
+  void RestoreTo(int64_t size) {
+    DCHECK_GE(size, 0);
+    while (size_ > size) {
+      const int count = std::min<int64_t>(current_, size_ - size);
+      DCHECK_GT(count, 0);
+      const T* const first = data_.get() + current_ - count;
+      for (const T* element = data_.get() + current_; element != first;) {
+        (--element)->restore();
+      }
+      current_ -= count;
+      size_ -= count;
       if (current_ <= 0) {
         if (buffer_used_) {
           data_.swap(buffer_);
@@ -661,10 +698,9 @@ class CompressedTrail {
           current_ = block_size_;
         }
       }
-      --size_;
     }
   }
-  void PushBack(const addrval<T>& addr_val) {
+  void PushBack(const T& element) {
     if (current_ >= block_size_) {
       if (buffer_used_) {  // Buffer is used.
         NewTopBlock();
@@ -677,7 +713,7 @@ class CompressedTrail {
       }
       current_ = 0;
     }
-    data_[current_] = addr_val;
+    data_[current_] = element;
     ++current_;
     ++size_;
   }
@@ -719,11 +755,11 @@ class CompressedTrail {
   const int block_size_;
   Block* blocks_;
   Block* free_blocks_;
-  std::unique_ptr<addrval<T>[]> data_;
-  std::unique_ptr<addrval<T>[]> buffer_;
+  std::unique_ptr<T[]> data_;
+  std::unique_ptr<T[]> buffer_;
   bool buffer_used_;
   int current_;
-  int size_;
+  int64_t size_;
 };
 }  // namespace
 
@@ -736,11 +772,7 @@ class CompressedTrail {
 extern void RestoreBoolValue(IntVar* const var);
 
 struct Trail {
-  CompressedTrail<int> rev_ints_;
-  CompressedTrail<int64_t> rev_int64s_;
-  CompressedTrail<uint64_t> rev_uint64s_;
-  CompressedTrail<double> rev_doubles_;
-  CompressedTrail<void*> rev_ptrs_;
+  CompressedTrail<TrailEntry> rev_values_;
   std::vector<IntVar*> rev_boolvar_list_;
   std::vector<bool*> rev_bools_;
   std::vector<bool> rev_bool_value_;
@@ -754,54 +786,13 @@ struct Trail {
 
   Trail(int block_size,
         ConstraintSolverParameters::TrailCompression compression_level)
-      : rev_ints_(block_size, compression_level),
-        rev_int64s_(block_size, compression_level),
-        rev_uint64s_(block_size, compression_level),
-        rev_doubles_(block_size, compression_level),
-        rev_ptrs_(block_size, compression_level) {}
+      : rev_values_(block_size, compression_level) {}
 
   void BacktrackTo(StateMarker* m) {
-    int target = m->rev_int_index_;
-    for (int curr = rev_ints_.size(); curr > target; --curr) {
-      const addrval<int>& cell = rev_ints_.Back();
-      cell.restore();
-      rev_ints_.PopBack();
-    }
-    DCHECK_EQ(rev_ints_.size(), target);
-    // Incorrect trail size after backtrack.
-    target = m->rev_int64_index_;
-    for (int curr = rev_int64s_.size(); curr > target; --curr) {
-      const addrval<int64_t>& cell = rev_int64s_.Back();
-      cell.restore();
-      rev_int64s_.PopBack();
-    }
-    DCHECK_EQ(rev_int64s_.size(), target);
-    // Incorrect trail size after backtrack.
-    target = m->rev_uint64_index_;
-    for (int curr = rev_uint64s_.size(); curr > target; --curr) {
-      const addrval<uint64_t>& cell = rev_uint64s_.Back();
-      cell.restore();
-      rev_uint64s_.PopBack();
-    }
-    DCHECK_EQ(rev_uint64s_.size(), target);
+    rev_values_.RestoreTo(m->rev_value_index_);
+    DCHECK_EQ(rev_values_.size(), m->rev_value_index_);
     // Incorrect trail size after backtrack.
-    target = m->rev_double_index_;
-    for (int curr = rev_doubles_.size(); curr > target; --curr) {
-      const addrval<double>& cell = rev_doubles_.Back();
-      cell.restore();
-      rev_doubles_.PopBack();
-    }
-    DCHECK_EQ(rev_doubles_.size(), target);
-    // Incorrect trail size after backtrack.
-    target = m->rev_ptr_index_;
-    for (int curr = rev_ptrs_.size(); curr > target; --curr) {
-      const addrval<void*>& cell = rev_ptrs_.Back();
-      cell.restore();
-      rev_ptrs_.PopBack();
-    }
-    DCHECK_EQ(rev_ptrs_.size(), target);
-    // Incorrect trail size after backtrack.
-    target = m->rev_boolvar_list_index_;
+    int target = m->rev_boolvar_list_index_;
     for (int curr = rev_boolvar_list_.size() - 1; curr >= target; --curr) {
       IntVar* const var = rev_boolvar_list_[curr];
       RestoreBoolValue(var);
@@ -869,23 +860,23 @@ struct Trail {
 };
 
 void Solver::InternalSaveValue(int* valptr) {
-  trail_->rev_ints_.PushBack(addrval<int>(valptr));
+  trail_->rev_values_.PushBack(TrailEntry(valptr));
 }
 
 void Solver::InternalSaveValue(int64_t* valptr) {
-  trail_->rev_int64s_.PushBack(addrval<int64_t>(valptr));
+  trail_->rev_values_.PushBack(TrailEntry(valptr));
 }
 
 void Solver::InternalSaveValue(uint64_t* valptr) {
-  trail_->rev_uint64s_.PushBack(addrval<uint64_t>(valptr));
+  trail_->rev_values_.PushBack(TrailEntry(valptr));
 }
 
 void Solver::InternalSaveValue(double* valptr) {
-  trail_->rev_doubles_.PushBack(addrval<double>(valptr));
+  trail_->rev_values_.PushBack(TrailEntry(valptr));
 }
 
 void Solver::InternalSaveValue(void** valptr) {
-  trail_->rev_ptrs_.PushBack(addrval<void*>(valptr));
+  trail_->rev_values_.PushBack(TrailEntry(valptr));
 }
 
 // TODO(user) : this code is unsafe if you save the same alternating
@@ -1600,11 +1591,7 @@ void Solver::PopState() {
 void Solver::PushState(Solver::MarkerType t, const StateInfo& info) {
   StateMarker* m = new StateMarker(t, info);
   if (t != REVERSIBLE_ACTION || info.int_info == 0) {
-    m->rev_int_index_ = trail_->rev_ints_.size();
-    m->rev_int64_index_ = trail_->rev_int64s_.size();
-    m->rev_uint64_index_ = trail_->rev_uint64s_.size();
-    m->rev_double_index_ = trail_->rev_doubles_.size();
-    m->rev_ptr_index_ = trail_->rev_ptrs_.size();
+    m->rev_value_index_ = trail_->rev_values_.size();
     m->rev_boolvar_list_index_ = trail_->rev_boolvar_list_.size();
     m->rev_bools_index_ = trail_->rev_bools_.size();
     m->rev_int_memory_index_ = trail_->rev_int_memory_.size();
@@ -2314,6 +2301,11 @@ void Solver::EndSearch() {
       LOG(INFO) << "Exporting profile to " << file_name;
       ExportProfilingOverview(file_name);
     }
+    if (!parameters_.profile_folded_stacks_file().empty()) {
+      const std::string& file_name = parameters_.profile_folded_stacks_file();
+      LOG(INFO) << "Exporting folded stacks profile to " << file_name;
+      ExportProfilingFoldedStacks(file_name);
+    }
     if (parameters_.print_local_search_profile()) {
       const std::string profile = LocalSearchProfile();
       if (!profile.empty()) LOG(INFO) << profile;
@@ -2268,6 +2268,23 @@ class Solver {
       int64_t step, const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars, double penalty_factor,
       bool reset_penalties_on_new_best_solution = false);
+  /// Same as above, except that the penalties of the values in
+  /// candidate_values[i] for vars[i] are stored in a flat array, the other
+  /// penalties being stored in a hash map. This is faster and uses less memory
+  /// than the default storage when most penalized values are known in advance,
+  /// e.g. the closest neighbors of each node for the next variables of a
+  /// routing model. The search is the same.
+  SearchMonitor* MakeGuidedLocalSearchWithCandidates(
+      bool maximize, IntVar* objective, IndexEvaluator2 objective_function,
+      int64_t step, const std::vector<IntVar*>& vars,
+      const std::vector<std::vector<int64_t>>& candidate_values,
+      double penalty_factor, bool reset_penalties_on_new_best_solution = false);
+  SearchMonitor* MakeGuidedLocalSearchWithCandidates(
+      bool maximize, IntVar* objective, IndexEvaluator3 objective_function,
+      int64_t step, const std::vector<IntVar*>& vars,
+      const std::vector<IntVar*>& secondary_vars,
+      const std::vector<std::vector<int64_t>>& candidate_values,
+      double penalty_factor, bool reset_penalties_on_new_best_solution = false);
 
   /// This search monitor will restart the search periodically.
   /// At the iteration n, it will restart after scale_factor * Luby(n) failures
@@ -2934,6 +2951,12 @@ class Solver {
   /// set to true.
   void ExportProfilingOverview(const std::string& filename);
 
+  /// Exports the profiling information in the folded stack format used by
+  /// flame graph tools: one "model;constraint;demon runtime" line per demon,
+  /// with runtimes in microseconds. The parameter profile_level used to create
+  /// the solver must be set to true.
+  void ExportProfilingFoldedStacks(const std::string& filename);
+
   /// Returns local search profiling information in a human readable format.
   // TODO(user): Merge demon and local search profiles.
   std::string LocalSearchProfile() const;
@@ -2996,6 +3019,9 @@ class Solver {
   bool InstrumentsDemons() const;
   /// Returns whether we are profiling the solver.
   bool IsProfilingEnabled() const;
+  /// Returns the average number of demon runs per run timed by the demon
+  /// profiler; 1 if all runs are timed.
+  int DemonRunsSamplingPeriod() const;
   /// Returns whether we are profiling local search.
   bool IsLocalSearchProfilingEnabled() const;
   /// Returns whether we are tracing variables.
@@ -5005,14 +5031,30 @@ class AssignmentContainer {
   E* FastAdd(V* var) {
     DCHECK(var != nullptr);
     elements_.emplace_back(var);
+    if (use_dense_lookup_) SetDensePosition(var, elements_.size() - 1);
     return &elements_.back();
   }
   /// Advanced usage: Adds element at a given position; position has to have
   /// been allocated with AssignmentContainer::Resize() beforehand.
   E* AddAtPosition(V* var, int position) {
     elements_[position].Reset(var);
+    if (use_dense_lookup_) SetDensePosition(var, position);
     return &elements_[position];
   }
+  /// Advanced usage: finds elements through a vector indexed by
+  /// IntVar::index() instead of a hash map, so that lookups are a single
+  /// array access and neither lookups nor Clear() allocate. The vector grows
+  /// up to the largest index of the variables added, which makes this
+  /// worthwhile for containers reused many times, like local search deltas.
+  /// Only available for containers of IntVar.
+  void EnableDenseLookup() {
+    if (use_dense_lookup_) return;
+    use_dense_lookup_ = true;
+    for (int i = 0; i < elements_.size(); ++i) {
+      const V* const var = elements_[i].Var();
+      if (var != nullptr) SetDensePosition(var, i);
+    }
+  }
   void Clear() {
     elements_.clear();
     if (!elements_map_.empty()) {  /// 2x speedup on OR-Tools.
@@ -5141,7 +5183,32 @@ class AssignmentContainer {
       (*map)[elements_[i].Var()] = i;
     }
   }
+  // Positions are not reset by Clear(): a position is only valid if it points
+  // to an element of the same variable.
+  void SetDensePosition(const V* const var, int position) {
+    const int key = DenseKey(var);
+    DCHECK_GE(key, 0) << "Dense lookup is only available for IntVar.";
+    if (key >= dense_positions_.size()) {
+      dense_positions_.resize(std::max<size_t>(key + 1,
+                                               2 * dense_positions_.size()),
+                              -1);
+    }
+    dense_positions_[key] = position;
+  }
+  static int DenseKey(const IntVar* const var) { return var->index(); }
+  static int DenseKey(const void* const var) { return -1; }
   bool Find(const V* const var, int* index) const {
+    if (use_dense_lookup_) {
+      const int key = DenseKey(var);
+      if (key < 0 || key >= dense_positions_.size()) return false;
+      const int position = dense_positions_[key];
+      if (position < 0 || position >= elements_.size() ||
+          elements_[position].Var() != var) {
+        return false;
+      }
+      *index = position;
+      return true;
+    }
     /// This threshold was determined from microbenchmarks on Nehalem platform.
     const size_t kMaxSizeForLinearAccess = 11;
     if (Size() <= kMaxSizeForLinearAccess) {
@@ -5164,6 +5231,8 @@ class AssignmentContainer {
 
   std::vector<E> elements_;
   absl::flat_hash_map<const V*, int> elements_map_;
+  bool use_dense_lookup_ = false;
+  std::vector<int> dense_positions_;
 };
 
 /// An Assignment is a variable -> domains mapping, used
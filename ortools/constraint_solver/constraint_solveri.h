@@ -62,6 +62,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "ortools/base/integral_types.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/timer.h"
@@ -97,6 +98,7 @@ namespace operations_research {
 /// This is a consequence of the stateless nature of the expressions that
 /// makes the code error-prone.
 class LocalSearchMonitor;
+class ThreadPool;
 
 class BaseIntExpr : public IntExpr {
  public:
@@ -1184,6 +1186,10 @@ class IntVarLocalSearchOperator : public LocalSearchOperator {
   int64_t OldInverseValue(int64_t index) const {
     return state_.CommittedInverseValue(index);
   }
+  /// Returns the indices of the variables changed by the current neighbor.
+  const std::vector<int64_t>& CandidateIndicesChanged() const {
+    return state_.CandidateIndicesChanged();
+  }
 
   void AddToAssignment(IntVar* var, int64_t value, bool active,
                        std::vector<int>* assignment_indices, int64_t index,
@@ -1284,6 +1290,29 @@ class ChangeValue : public IntVarLocalSearchOperator {
   int index_;
 };
 
+#if !defined(SWIG)
+/// Candidate successors of nodes, stored in compressed sparse row format: the
+/// sorted candidates of a node are contiguous in a single vector.
+class ArcCandidates {
+ public:
+  explicit ArcCandidates(
+      const std::vector<std::vector<int64_t>>& candidates_per_node);
+
+  /// Returns true if next is a candidate successor of node.
+  bool Contains(int64_t node, int64_t next) const;
+  /// Returns the sorted candidate successors of node.
+  absl::Span<const int64_t> Candidates(int64_t node) const {
+    if (node + 1 >= starts_.size()) return {};
+    return absl::MakeConstSpan(candidates_.data() + starts_[node],
+                               starts_[node + 1] - starts_[node]);
+  }
+
+ private:
+  std::vector<int> starts_;
+  std::vector<int64_t> candidates_;
+};
+#endif  // !defined(SWIG)
+
 /// Base class of the local search operators dedicated to path modifications
 /// (a path is a set of nodes linked together by arcs).
 /// This family of neighborhoods supposes they are handling next variables
@@ -1335,6 +1364,26 @@ class PathOperator : public IntVarLocalSearchOperator {
   ~PathOperator() override {}
   virtual bool MakeNeighbor() = 0;
   void Reset() override;
+#if !defined(SWIG)
+  /// Granular neighborhoods: only returns the neighbors adding at least one
+  /// arc (node, next) where next is a candidate of node.
+  /// Operators overriding CanEnumerateArcCandidates() (currently TwoOpt,
+  /// multi-path Relocate and Exchange) then only enumerate the pairs made of a
+  /// single base node and one of its candidates (see HasNeighbors()). The
+  /// neighbors of the other operators are still enumerated, but the ones not
+  /// adding a candidate arc are discarded before being filtered; arcs leaving
+  /// path starts or reaching path ends are then always considered as
+  /// candidates, and neighbors making nodes inactive are not restricted.
+  /// Must be called before the operator is started. 'arc_candidates' must
+  /// outlive the operator; nullptr disables the restriction.
+  void SetArcCandidates(const ArcCandidates* arc_candidates);
+  /// Returns true if the operator only enumerates arc candidates.
+  bool HasNeighbors() const { return has_neighbors_; }
+  /// Returns true if MakeNeighbor() supports enumerating arc candidates: when
+  /// arc candidates are set, the operator then has a single base node and
+  /// MakeNeighbor() must add the arc from BaseNode(0) to BaseNeighbor().
+  virtual bool CanEnumerateArcCandidates() const { return false; }
+#endif  // !defined(SWIG)
 
   // TODO(user): Make the following methods protected.
   bool SkipUnchanged(int index) const override;
@@ -1371,6 +1420,17 @@ class PathOperator : public IntVarLocalSearchOperator {
 
   /// Returns the ith base node of the operator.
   int64_t BaseNode(int i) const { return base_nodes_[i]; }
+#if !defined(SWIG)
+  /// Returns the arc candidate of the base node currently considered, or -1 if
+  /// the base node has no candidate. Only valid if HasNeighbors().
+  int64_t BaseNeighbor() const {
+    DCHECK(HasNeighbors());
+    const absl::Span<const int64_t> candidates =
+        arc_candidates_->Candidates(BaseNode(0));
+    return neighbor_index_ < candidates.size() ? candidates[neighbor_index_]
+                                               : -1;
+  }
+#endif  // !defined(SWIG)
   /// Returns the alternative for the ith base node.
   int BaseAlternative(int i) const { return base_alternatives_[i]; }
   /// Returns the alternative node for the ith base node.
@@ -1574,6 +1634,9 @@ class PathOperator : public IntVarLocalSearchOperator {
   bool OnSamePath(int64_t node1, int64_t node2) const;
 
   bool CheckEnds() const {
+    // The candidates of the base node at which the iteration started have not
+    // all been considered yet.
+    if (neighbor_index_ != 0) return true;
     const int base_node_size = base_nodes_.size();
     for (int i = base_node_size - 1; i >= 0; --i) {
       if (base_nodes_[i] != end_nodes_[i]) {
@@ -1583,6 +1646,8 @@ class PathOperator : public IntVarLocalSearchOperator {
     return false;
   }
   bool IncrementPosition();
+  /// Returns true if the current neighbor is allowed by arc_candidates_.
+  bool AddsCandidateArc() const;
   void InitializePathStarts();
   void InitializeInactives();
   void InitializeBaseNodes();
@@ -1610,6 +1675,12 @@ class PathOperator : public IntVarLocalSearchOperator {
   std::vector<int> alternative_index_;
   std::vector<int64_t> active_in_alternative_set_;
   std::vector<int> sibling_alternative_;
+#ifndef SWIG
+  const ArcCandidates* arc_candidates_ = nullptr;
+#endif  // SWIG
+  bool has_neighbors_ = false;
+  /// Index of the candidate of the base node currently considered.
+  int neighbor_index_ = 0;
 };
 
 /// Operator Factories.
@@ -1786,6 +1857,7 @@ class LocalSearchFilterManager : public BaseObject {
   // Builds a manager that calls filter methods using the following ordering:
   // first Relax() in vector order, then Accept() in vector order.
   explicit LocalSearchFilterManager(std::vector<LocalSearchFilter*> filters);
+  ~LocalSearchFilterManager() override;
 
   // Calls Revert() of filters, in reverse order of Relax events.
   void Revert();
@@ -1799,13 +1871,55 @@ class LocalSearchFilterManager : public BaseObject {
   void Synchronize(const Assignment* assignment, const Assignment* delta);
   int64_t GetSynchronizedObjectiveValue() const { return synchronized_value_; }
   int64_t GetAcceptedObjectiveValue() const { return accepted_value_; }
+  /// If adaptive ordering is on, the manager measures the number of rejections
+  /// and the running time of the Accept() of each filter, and periodically
+  /// reorders filters by decreasing number of rejections per unit of time.
+  /// Filters are only reordered within their priority; incremental filters and
+  /// filters with a kRelax event keep their position.
+  void SetAdaptiveOrdering(bool adaptive_ordering);
+
+  /// Replicas are managers with their own copies of the filters of this
+  /// manager, used by AcceptFirst() to filter candidates on several threads.
+  /// They are synchronized with this manager, and their Accept() must only
+  /// read state shared with other filters. Replicas are not owned.
+  void SetReplicas(std::vector<LocalSearchFilterManager*> replicas);
+  int NumReplicas() const { return replicas_.size(); }
+  struct Candidate {
+    const Assignment* delta;
+    int64_t objective_min;
+    int64_t objective_max;
+  };
+  /// Filters candidates concurrently with the replicas, candidate i being
+  /// filtered by replica i % NumReplicas(), with an empty deltadelta.
+  /// Returns the index of the first candidate accepted by its replica, or
+  /// candidates.size() if none is. The candidates after the returned one might
+  /// not have been filtered. This manager is not called.
+  int AcceptFirst(absl::Span<const Candidate> candidates,
+                  const Assignment* empty_deltadelta);
 
  private:
+  // Statistics of the Accept() calls of an event, decayed at each reordering.
+  struct EventStats {
+    bool reorderable = false;
+    int64_t num_rejects = 0;
+    int64_t time_ns = 0;
+  };
+
   // Finds the last event (incremental -itself- or not) with the same priority
   // as the last incremental event.
   void FindIncrementalEventEnd();
+  // Sorts the reorderable kAccept events of each priority by decreasing
+  // rejections per nanosecond, and decays their statistics.
+  void ReorderAcceptEvents();
 
   std::vector<FilterEvent> events_;
+  // Parallel to events_, empty unless adaptive ordering is on.
+  std::vector<EventStats> event_stats_;
+  int num_accepts_since_reordering_ = 0;
+  std::vector<LocalSearchFilterManager*> replicas_;
+  // Runs AcceptFirst() on NumReplicas() - 1 threads, the calling thread
+  // taking the first replica.
+  std::unique_ptr<ThreadPool> replica_pool_;
   int last_event_called_ = -1;
   // If a filter is incremental, its Relax() and Accept() must be called for
   // every candidate, even if the Accept() of a prior filter rejected it.
@@ -15,6 +15,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "ortools/base/file.h"
@@ -55,7 +57,10 @@ class DemonProfiler : public PropagationMonitor {
       : PropagationMonitor(solver),
         active_constraint_(nullptr),
         active_demon_(nullptr),
-        start_time_ns_(absl::GetCurrentTimeNanos()) {}
+        start_time_ns_(absl::GetCurrentTimeNanos()),
+        sampling_period_(solver->DemonRunsSamplingPeriod()),
+        demon_runs_to_next_sample_(0),
+        sampling_interval_(0, 2 * (sampling_period_ - 1)) {}
 
   ~DemonProfiler() override {
     gtl::STLDeleteContainerPairSecondPointers(constraint_map_.begin(),
@@ -151,6 +156,7 @@ class DemonProfiler : public PropagationMonitor {
       return;
     }
     CHECK(active_demon_ == nullptr);
+    if (!SamplesNextDemonRun()) return;
     active_demon_ = demon;
     DemonRuns* const demon_run = demon_map_[active_demon_];
     if (demon_run != nullptr) {
@@ -163,6 +169,8 @@ class DemonProfiler : public PropagationMonitor {
     if (demon->priority() == Solver::VAR_PRIORITY) {
       return;
     }
+    // Unsampled runs are not timed.
+    if (active_demon_ == nullptr) return;
     CHECK_EQ(active_demon_, demon);
     DemonRuns* const demon_run = demon_map_[active_demon_];
     if (demon_run != nullptr) {
@@ -328,7 +336,62 @@ class DemonProfiler : public PropagationMonitor {
     file->Close(file::Defaults()).IgnoreError();
   }
 
+  // Exports collected data in the folded stack format of flame graph tools.
+  // Demons are children of their constraint, itself a child of the model; the
+  // initial propagation of a constraint is reported as a separate child.
+  void PrintFoldedStacks(Solver* const solver, const std::string& filename) {
+    // ';' separates stack frames and new lines separate stacks.
+    const auto frame = [](absl::string_view name) {
+      std::string result(name);
+      std::replace(result.begin(), result.end(), ';', ',');
+      std::replace(result.begin(), result.end(), '\n', ' ');
+      return result;
+    };
+    File* file;
+    if (!file::Open(filename, "w", &file, file::Defaults()).ok()) return;
+    const std::string model = frame(solver->model_name());
+    for (const auto& [ct, ct_run] : constraint_map_) {
+      int64_t fails = 0;
+      int64_t demon_invocations = 0;
+      int64_t initial_propagation_runtime = 0;
+      int64_t total_demon_runtime = 0;
+      int demon_count = 0;
+      ExportInformation(ct, &fails, &initial_propagation_runtime,
+                        &demon_invocations, &total_demon_runtime,
+                        &demon_count);
+      const std::string constraint = frame(ct_run->constraint_id());
+      if (initial_propagation_runtime > 0) {
+        file::WriteString(file,
+                          absl::StrFormat("%s;%s;InitialPropagation %d\n",
+                                          model, constraint,
+                                          initial_propagation_runtime),
+                          file::Defaults())
+            .IgnoreError();
+      }
+      for (const DemonRuns* const demon_runs : demons_per_constraint_[ct]) {
+        int64_t invocations = 0;
+        int64_t fails = 0;
+        int64_t runtime = 0;
+        double mean_runtime = 0;
+        double median_runtime = 0;
+        double standard_deviation = 0.0;
+        ExportInformation(demon_runs, &invocations, &fails, &runtime,
+                          &mean_runtime, &median_runtime, &standard_deviation);
+        if (runtime <= 0) continue;
+        file::WriteString(
+            file,
+            absl::StrFormat("%s;%s;%s %d\n", model, constraint,
+                            frame(demon_runs->demon_id()), runtime),
+            file::Defaults())
+            .IgnoreError();
+      }
+    }
+    file->Close(file::Defaults()).IgnoreError();
+  }
+
   // Export Information
+  // When sampling, invocations, failures and runtimes of demons are
+  // extrapolated from the sampled runs.
   void ExportInformation(const Constraint* const constraint,
                          int64_t* const fails,
                          int64_t* const initial_propagation_runtime,
@@ -361,6 +424,12 @@ class DemonProfiler : public PropagationMonitor {
         *total_demon_runtime += demon_time;
       }
     }
+    if (sampling_period_ > 1) {
+      const int64_t demon_fails = *fails - ct_run->failures();
+      *fails = ct_run->failures() + demon_fails * sampling_period_;
+      *demon_invocations *= sampling_period_;
+      *total_demon_runtime *= sampling_period_;
+    }
   }
 
   void ExportInformation(const DemonRuns* const demon_runs,
@@ -373,8 +442,8 @@ class DemonProfiler : public PropagationMonitor {
     CHECK_EQ(demon_runs->start_time_size(), demon_runs->end_time_size());
 
     const int runs = demon_runs->start_time_size();
-    *demon_invocations = runs;
-    *fails = demon_runs->failures();
+    *demon_invocations = runs * sampling_period_;
+    *fails = demon_runs->failures() * sampling_period_;
     *total_demon_runtime = 0;
     *mean_demon_runtime = 0.0;
     *median_demon_runtime = 0.0;
@@ -389,6 +458,7 @@ class DemonProfiler : public PropagationMonitor {
     // Compute mean.
     if (!runtimes.empty()) {
       *mean_demon_runtime = (1.0L * *total_demon_runtime) / runtimes.size();
+      *total_demon_runtime *= sampling_period_;
 
       // Compute median.
       std::sort(runtimes.begin(), runtimes.end());
@@ -422,9 +492,31 @@ class DemonProfiler : public PropagationMonitor {
   std::string DebugString() const override { return "DemonProfiler"; }
 
  private:
+  // Returns true if the next demon run must be timed.
+  bool SamplesNextDemonRun() {
+    if (sampling_period_ == 1) return true;
+    if (demon_runs_to_next_sample_ > 0) {
+      --demon_runs_to_next_sample_;
+      return false;
+    }
+    demon_runs_to_next_sample_ = sampling_interval_(sampling_random_);
+    return true;
+  }
+
   Constraint* active_constraint_;
   Demon* active_demon_;
   const int64_t start_time_ns_;
+  // Only one demon run out of sampling_period_ on average is timed, see
+  // Solver::DemonRunsSamplingPeriod(). Runs are sampled at random so that the
+  // sampled runs do not follow the periodic patterns of propagation: the
+  // number of runs skipped between two sampled runs is uniform in
+  // [0, 2 * (sampling_period_ - 1)]. A dedicated generator is used to keep the
+  // search independent of profiling. Sampling only applies to the profiler;
+  // the other propagation monitors are notified of all demon runs.
+  const int sampling_period_;
+  int demon_runs_to_next_sample_;
+  std::mt19937 sampling_random_;
+  std::uniform_int_distribution<int> sampling_interval_;
   absl::flat_hash_map<const Constraint*, ConstraintRuns*> constraint_map_;
   absl::flat_hash_map<const Demon*, DemonRuns*> demon_map_;
   absl::flat_hash_map<const Constraint*, std::vector<DemonRuns*> >
@@ -437,6 +529,12 @@ void Solver::ExportProfilingOverview(const std::string& filename) {
   }
 }
 
+void Solver::ExportProfilingFoldedStacks(const std::string& filename) {
+  if (demon_profiler_ != nullptr) {
+    demon_profiler_->PrintFoldedStacks(this, filename);
+  }
+}
+
 // ----- Exported Functions -----
 
 void InstallDemonProfiler(DemonProfiler* const monitor) { monitor->Install(); }
@@ -877,6 +877,7 @@ import java.util.HashSet;
 %ignore Solver::SetBranchSelector;
 %ignore Solver::MakeApplyBranchSelector;
 %ignore Solver::MakeAtMost;
+%ignore Solver::MakeGuidedLocalSearchWithCandidates;
 %ignore Solver::Now;
 %ignore Solver::demon_profiler;
 %ignore Solver::set_fail_intercept;
@@ -897,6 +898,7 @@ import java.util.HashSet;
 %rename (currentlyInSolve) Solver::CurrentlyInSolve;
 %rename (defaultSolverParameters) Solver::DefaultSolverParameters;
 %rename (endSearch) Solver::EndSearch;
+%rename (exportProfilingFoldedStacks) Solver::ExportProfilingFoldedStacks;
 %rename (exportProfilingOverview) Solver::ExportProfilingOverview;
 %rename (fail) Solver::Fail;
 %rename (filteredNeighbors) Solver::filtered_neighbors;
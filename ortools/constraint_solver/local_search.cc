@@ -12,6 +12,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <iterator>
@@ -32,6 +33,8 @@
 #include "absl/random/distributions.h"
 #include "absl/random/random.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
 #include "ortools/base/commandlineflags.h"
 #include "ortools/base/hash.h"
 #include "ortools/base/integral_types.h"
@@ -39,6 +42,7 @@
 #include "ortools/base/logging.h"
 #include "ortools/base/macros.h"
 #include "ortools/base/map_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
 #include "ortools/graph/hamiltonian_path.h"
@@ -345,6 +349,27 @@ class DecrementValue : public ChangeValue {
 
 // ----- Path-based Operators -----
 
+// ----- ArcCandidates -----
+
+ArcCandidates::ArcCandidates(
+    const std::vector<std::vector<int64_t>>& candidates_per_node) {
+  starts_.reserve(candidates_per_node.size() + 1);
+  starts_.push_back(0);
+  for (const std::vector<int64_t>& candidates : candidates_per_node) {
+    const int start = candidates_.size();
+    candidates_.insert(candidates_.end(), candidates.begin(), candidates.end());
+    std::sort(candidates_.begin() + start, candidates_.end());
+    candidates_.erase(std::unique(candidates_.begin() + start, candidates_.end()),
+                      candidates_.end());
+    starts_.push_back(candidates_.size());
+  }
+}
+
+bool ArcCandidates::Contains(int64_t node, int64_t next) const {
+  const absl::Span<const int64_t> candidates = Candidates(node);
+  return std::binary_search(candidates.begin(), candidates.end(), next);
+}
+
 PathOperator::PathOperator(const std::vector<IntVar*>& next_vars,
                            const std::vector<IntVar*>& path_vars,
                            IterationParameters iteration_parameters)
@@ -381,6 +406,29 @@ PathOperator::PathOperator(const std::vector<IntVar*>& next_vars,
 
 void PathOperator::Reset() { optimal_paths_.clear(); }
 
+void PathOperator::SetArcCandidates(const ArcCandidates* arc_candidates) {
+  DCHECK(first_start_);
+  arc_candidates_ = arc_candidates;
+  if (arc_candidates_ == nullptr || !CanEnumerateArcCandidates()) {
+    DCHECK(!has_neighbors_);
+    return;
+  }
+  if (has_neighbors_) return;
+  has_neighbors_ = true;
+  // The second base node is replaced by the candidates of the first one.
+  iteration_parameters_.number_of_base_nodes = 1;
+  next_base_to_increment_ = 1;
+  base_nodes_.resize(1);
+  base_alternatives_.resize(1);
+  base_sibling_alternatives_.resize(1);
+  end_nodes_.resize(1);
+  base_paths_.resize(1);
+  path_basis_.assign(1, 0);
+  // Candidates can be on any path, so a path can no longer be considered as
+  // locally optimal when only this path is unchanged.
+  iteration_parameters_.skip_locally_optimal_paths = false;
+}
+
 void PathOperator::OnStart() {
   optimal_paths_enabled_ = false;
   InitializeBaseNodes();
@@ -393,7 +441,22 @@ bool PathOperator::MakeOneNeighbor() {
     // Need to revert changes here since MakeNeighbor might have returned false
     // and have done changes in the previous iteration.
     RevertChanges(true);
-    if (MakeNeighbor()) {
+    if (MakeNeighbor() &&
+        (arc_candidates_ == nullptr || has_neighbors_ || AddsCandidateArc())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PathOperator::AddsCandidateArc() const {
+  for (const int64_t node : CandidateIndicesChanged()) {
+    if (node >= number_of_nexts_) continue;
+    if (!Activated(node)) return true;
+    const int64_t next = Value(node);
+    if (next == OldValue(node)) continue;
+    if (next == node || IsPathStart(node) || IsPathEnd(next) ||
+        arc_candidates_->Contains(node, next)) {
       return true;
     }
   }
@@ -530,6 +593,13 @@ bool PathOperator::IncrementPosition() {
         }
         base_alternatives_[i] = 0;
         base_sibling_alternatives_[i] = 0;
+        // Iterate on the candidates of the base node.
+        if (has_neighbors_ &&
+            ++neighbor_index_ <
+                arc_candidates_->Candidates(base_nodes_[i]).size()) {
+          break;
+        }
+        neighbor_index_ = 0;
         base_nodes_[i] = OldNext(base_nodes_[i]);
         if (iteration_parameters_.accept_path_end_base ||
             !IsPathEnd(base_nodes_[i]))
@@ -809,6 +879,7 @@ void PathOperator::InitializeBaseNodes() {
     base_alternatives_[i] = 0;
     base_sibling_alternatives_[i] = 0;
   }
+  neighbor_index_ = 0;
   just_started_ = true;
 }
 
@@ -890,7 +961,8 @@ class TwoOpt : public PathOperator {
         last_(-1) {}
   ~TwoOpt() override {}
   bool MakeNeighbor() override;
-  bool IsIncremental() const override { return true; }
+  bool IsIncremental() const override { return !HasNeighbors(); }
+  bool CanEnumerateArcCandidates() const override { return true; }
 
   std::string DebugString() const override { return "TwoOpt"; }
 
@@ -911,6 +983,19 @@ class TwoOpt : public PathOperator {
 };
 
 bool TwoOpt::MakeNeighbor() {
+  if (HasNeighbors()) {
+    // Reverses the chain between the base node and its neighbor, the neighbor
+    // then follows the base node.
+    const int64_t node0 = BaseNode(0);
+    const int64_t neighbor = BaseNeighbor();
+    if (IsPathEnd(node0) || neighbor < 0 || IsPathStart(neighbor) ||
+        IsPathEnd(neighbor) || IsInactive(neighbor) ||
+        Next(node0) == neighbor) {
+      return false;
+    }
+    int64_t chain_last;
+    return ReverseChain(node0, Next(neighbor), &chain_last);
+  }
   DCHECK_EQ(StartNode(0), StartNode(1));
   if (last_base_ != BaseNode(0) || last_ == -1) {
     RevertChanges(false);
@@ -973,6 +1058,7 @@ class Relocate : public PathOperator {
   }
   ~Relocate() override {}
   bool MakeNeighbor() override;
+  bool CanEnumerateArcCandidates() const override { return !single_path_; }
 
   std::string DebugString() const override { return name_; }
 
@@ -990,6 +1076,25 @@ class Relocate : public PathOperator {
 };
 
 bool Relocate::MakeNeighbor() {
+  if (HasNeighbors()) {
+    // Moves the chain starting at the neighbor of the base node after the base
+    // node.
+    const int64_t destination = BaseNode(0);
+    const int64_t chain_start = BaseNeighbor();
+    if (IsPathEnd(destination) || chain_start < 0 ||
+        IsPathStart(chain_start) || IsPathEnd(chain_start) ||
+        IsInactive(chain_start)) {
+      return false;
+    }
+    int64_t chain_end = chain_start;
+    for (int i = 1; i < chain_length_; ++i) {
+      if (chain_end == destination) return false;
+      chain_end = Next(chain_end);
+      if (IsPathEnd(chain_end)) return false;
+    }
+    return chain_end != destination &&
+           MoveChain(Prev(chain_start), chain_end, destination);
+  }
   DCHECK(!single_path_ || StartNode(0) == StartNode(1));
   const int64_t destination = BaseNode(1);
   DCHECK(!IsPathEnd(destination));
@@ -1024,6 +1129,7 @@ class Exchange : public PathOperator {
                      std::move(start_empty_path_class)) {}
   ~Exchange() override {}
   bool MakeNeighbor() override;
+  bool CanEnumerateArcCandidates() const override { return true; }
 
   std::string DebugString() const override { return "Exchange"; }
 };
@@ -1032,9 +1138,22 @@ bool Exchange::MakeNeighbor() {
   const int64_t prev_node0 = BaseNode(0);
   const int64_t node0 = Next(prev_node0);
   if (IsPathEnd(node0)) return false;
-  const int64_t prev_node1 = BaseNode(1);
-  const int64_t node1 = Next(prev_node1);
-  if (IsPathEnd(node1)) return false;
+  int64_t prev_node1;
+  int64_t node1;
+  if (HasNeighbors()) {
+    // Exchanges node0 with the neighbor of the base node, the neighbor then
+    // follows the base node.
+    node1 = BaseNeighbor();
+    if (node1 < 0 || node1 == node0 || IsPathStart(node1) ||
+        IsPathEnd(node1) || IsInactive(node1)) {
+      return false;
+    }
+    prev_node1 = Prev(node1);
+  } else {
+    prev_node1 = BaseNode(1);
+    node1 = Next(prev_node1);
+    if (IsPathEnd(node1)) return false;
+  }
   const bool ok = MoveChain(prev_node0, node0, prev_node1);
   return MoveChain(Prev(node1), node1, prev_node0) || ok;
 }
@@ -4169,6 +4288,115 @@ LocalSearchFilterManager::LocalSearchFilterManager(
   FindIncrementalEventEnd();
 }
 
+LocalSearchFilterManager::~LocalSearchFilterManager() = default;
+
+void LocalSearchFilterManager::SetReplicas(
+    std::vector<LocalSearchFilterManager*> replicas) {
+  replicas_ = std::move(replicas);
+  replica_pool_.reset();
+  if (replicas_.size() > 1) {
+    replica_pool_ = std::make_unique<ThreadPool>("LocalSearchFilterReplicas",
+                                                 replicas_.size() - 1);
+    replica_pool_->StartWorkers();
+  }
+}
+
+int LocalSearchFilterManager::AcceptFirst(
+    absl::Span<const Candidate> candidates,
+    const Assignment* empty_deltadelta) {
+  DCHECK(empty_deltadelta->Empty());
+  const int num_candidates = candidates.size();
+  const int num_replicas = replicas_.size();
+  std::atomic<int> first_accepted = num_candidates;
+  // Each replica filters its candidates in order, and stops as soon as one of
+  // them is accepted or comes after an accepted candidate.
+  const auto filter_candidates = [&](int replica_index) {
+    LocalSearchFilterManager* const replica = replicas_[replica_index];
+    for (int c = replica_index; c < num_candidates; c += num_replicas) {
+      if (c > first_accepted.load(std::memory_order_relaxed)) break;
+      const auto [delta, objective_min, objective_max] = candidates[c];
+      const bool accept = replica->Accept(/*monitor=*/nullptr, delta,
+                                          empty_deltadelta, objective_min,
+                                          objective_max);
+      replica->Revert();
+      if (!accept) continue;
+      int current = first_accepted.load(std::memory_order_relaxed);
+      while (c < current && !first_accepted.compare_exchange_weak(
+                                current, c, std::memory_order_relaxed)) {
+      }
+      break;
+    }
+  };
+  const int num_tasks = std::min(num_replicas, num_candidates);
+  absl::BlockingCounter replicas_running(std::max(0, num_tasks - 1));
+  for (int r = 1; r < num_tasks; ++r) {
+    replica_pool_->Schedule([&, r]() {
+      filter_candidates(r);
+      replicas_running.DecrementCount();
+    });
+  }
+  if (num_tasks > 0) filter_candidates(0);
+  replicas_running.Wait();
+  return first_accepted.load();
+}
+
+void LocalSearchFilterManager::SetAdaptiveOrdering(bool adaptive_ordering) {
+  event_stats_.clear();
+  num_accepts_since_reordering_ = 0;
+  if (!adaptive_ordering) return;
+  absl::flat_hash_set<const LocalSearchFilter*> relaxed_filters;
+  for (const auto& [filter, event_type, _priority] : events_) {
+    if (event_type == FilterEventType::kRelax) relaxed_filters.insert(filter);
+  }
+  event_stats_.resize(events_.size());
+  for (int e = 0; e < events_.size(); ++e) {
+    const auto& [filter, event_type, _priority] = events_[e];
+    event_stats_[e].reorderable = event_type == FilterEventType::kAccept &&
+                                  !filter->IsIncremental() &&
+                                  !relaxed_filters.contains(filter);
+  }
+}
+
+void LocalSearchFilterManager::ReorderAcceptEvents() {
+  // A filter that was never called is assumed to reject every neighbor in
+  // kPriorTimeNs, so that it gets a chance to move forward.
+  constexpr double kPriorTimeNs = 1000.0;
+  const auto score = [](const EventStats& stats) {
+    return (stats.num_rejects + 1.0) / (stats.time_ns + kPriorTimeNs);
+  };
+  std::vector<int> slots;
+  std::vector<std::pair<FilterEvent, EventStats>> moved_events;
+  const int num_events = events_.size();
+  for (int begin = 0; begin < num_events;) {
+    int end = begin;
+    slots.clear();
+    while (end < num_events &&
+           events_[end].priority == events_[begin].priority) {
+      if (event_stats_[end].reorderable) slots.push_back(end);
+      ++end;
+    }
+    if (slots.size() > 1) {
+      moved_events.clear();
+      for (const int e : slots) {
+        moved_events.push_back({events_[e], event_stats_[e]});
+      }
+      std::stable_sort(moved_events.begin(), moved_events.end(),
+                       [&score](const auto& a, const auto& b) {
+                         return score(a.second) > score(b.second);
+                       });
+      for (int i = 0; i < slots.size(); ++i) {
+        events_[slots[i]] = moved_events[i].first;
+        event_stats_[slots[i]] = moved_events[i].second;
+      }
+    }
+    begin = end;
+  }
+  for (EventStats& stats : event_stats_) {
+    stats.num_rejects /= 2;
+    stats.time_ns /= 2;
+  }
+}
+
 // Filters' Revert() must be called in the reverse order in which their
 // Relax() was called.
 void LocalSearchFilterManager::Revert() {
@@ -4188,9 +4416,18 @@ bool LocalSearchFilterManager::Accept(LocalSearchMonitor* const monitor,
                                       int64_t objective_min,
                                       int64_t objective_max) {
   Revert();
+  const bool adaptive_ordering = !event_stats_.empty();
+  if (adaptive_ordering) {
+    constexpr int kNumAcceptsBetweenReorderings = 1000;
+    if (++num_accepts_since_reordering_ == kNumAcceptsBetweenReorderings) {
+      num_accepts_since_reordering_ = 0;
+      ReorderAcceptEvents();
+    }
+  }
   accepted_value_ = 0;
   bool feasible = true;
-  bool reordered = false;
+  // Adaptive ordering replaces the bump of the rejecting event.
+  bool reordered = adaptive_ordering;
   int events_end = events_.size();
   for (int e = 0; e < events_end; ++e) {
     last_event_called_ = e;
@@ -4199,9 +4436,15 @@ bool LocalSearchFilterManager::Accept(LocalSearchMonitor* const monitor,
       case FilterEventType::kAccept: {
         if (!feasible && !filter->IsIncremental()) continue;
         if (monitor != nullptr) monitor->BeginFiltering(filter);
+        const bool timed = adaptive_ordering && event_stats_[e].reorderable;
+        const int64_t start_time_ns = timed ? absl::GetCurrentTimeNanos() : 0;
         const bool accept = filter->Accept(
             delta, deltadelta, CapSub(objective_min, accepted_value_),
             CapSub(objective_max, accepted_value_));
+        if (timed) {
+          event_stats_[e].time_ns +=
+              absl::GetCurrentTimeNanos() - start_time_ns;
+        }
         feasible &= accept;
         if (monitor != nullptr) monitor->EndFiltering(filter, !accept);
         if (feasible) {
@@ -4211,6 +4454,9 @@ bool LocalSearchFilterManager::Accept(LocalSearchMonitor* const monitor,
           feasible = accepted_value_ <= objective_max;
         }
         if (!feasible) {
+          // Reorderable filters are only called on feasible candidates, so
+          // this one is responsible for the rejection.
+          if (timed) ++event_stats_[e].num_rejects;
           events_end = incremental_events_end_;
           if (!reordered) {
             // Bump up rejected event, together with its kRelax event,
@@ -4282,6 +4528,9 @@ void LocalSearchFilterManager::Synchronize(const Assignment* assignment,
         LOG(FATAL) << "Unknown filter event type.";
     }
   }
+  for (LocalSearchFilterManager* replica : replicas_) {
+    replica->Synchronize(assignment, delta);
+  }
 }
 
 // ----- Finds a neighbor of the assignment passed -----
@@ -4301,6 +4550,15 @@ class FindOneNeighbor : public DecisionBuilder {
  private:
   bool FilterAccept(Solver* solver, Assignment* delta, Assignment* deltadelta,
                     int64_t objective_min, int64_t objective_max);
+  // Used instead of MakeNextNeighbor() of the operator when the filter manager
+  // has replicas: neighbors are made by batches, filtered concurrently by the
+  // replicas, and only the ones they accept are copied to delta. Returns false
+  // when the operator or the limit stops before a neighbor is accepted.
+  // Note that the operator runs ahead of the neighbors returned by up to a
+  // batch, which can change the exploration of operators keeping a state
+  // across restarts, such as compound operators.
+  bool MakeNextReplicaFilteredNeighbor(Solver* solver, Assignment* delta,
+                                       Assignment* deltadelta);
   void SynchronizeAll(Solver* solver);
 
   Assignment* const assignment_;
@@ -4319,6 +4577,17 @@ class FindOneNeighbor : public DecisionBuilder {
   int64_t check_period_;
   Assignment last_checked_assignment_;
   bool has_checked_assignment_ = false;
+  // Neighbors made on the reference assignment but not sent to the filter
+  // manager yet, from batch_candidates_[batch_next_]. The deltas are stored in
+  // batch_deltas_ and the operator writes to its own operator_delta_.
+  std::vector<std::unique_ptr<Assignment>> batch_deltas_;
+  std::vector<LocalSearchFilterManager::Candidate> batch_candidates_;
+  int batch_next_ = 0;
+  // True if the operator or the limit stopped before the batch was full.
+  bool batch_is_last_ = false;
+  Assignment* operator_delta_ = nullptr;
+  Assignment* operator_deltadelta_ = nullptr;
+  Assignment* empty_deltadelta_ = nullptr;
 };
 
 // reference_assignment_ is used to keep track of the last assignment on which
@@ -4375,6 +4644,17 @@ FindOneNeighbor::FindOneNeighbor(Assignment* const assignment,
   if (!reference_assignment_->HasObjective()) {
     reference_assignment_->AddObjective(objective_);
   }
+  // The assignments below are cleared and looked up for every neighbor;
+  // looking their variables up by index avoids hashing and reallocating.
+  reference_assignment_->MutableIntVarContainer()->EnableDenseLookup();
+  filter_assignment_delta_->MutableIntVarContainer()->EnableDenseLookup();
+  if (filter_manager_ != nullptr && filter_manager_->NumReplicas() > 0) {
+    operator_delta_ = solver->MakeAssignment();
+    operator_deltadelta_ = solver->MakeAssignment();
+    empty_deltadelta_ = solver->MakeAssignment();
+    operator_delta_->MutableIntVarContainer()->EnableDenseLookup();
+    operator_deltadelta_->MutableIntVarContainer()->EnableDenseLookup();
+  }
 }
 
 Decision* FindOneNeighbor::Next(Solver* const solver) {
@@ -4388,6 +4668,12 @@ Decision* FindOneNeighbor::Next(Solver* const solver) {
     last_checked_assignment_.AddObjective(assignment_->Objective());
   }
 
+  // Neighbors batched in a previous call were made before the solution it
+  // returned was committed.
+  batch_candidates_.clear();
+  batch_next_ = 0;
+  batch_is_last_ = false;
+
   if (!neighbor_found_) {
     // Only called on the first call to Next(), reference_assignment_ has not
     // been synced with assignment_ yet
@@ -4411,6 +4697,8 @@ Decision* FindOneNeighbor::Next(Solver* const solver) {
     }
     Assignment* delta = solver->MakeAssignment();
     Assignment* deltadelta = solver->MakeAssignment();
+    delta->MutableIntVarContainer()->EnableDenseLookup();
+    deltadelta->MutableIntVarContainer()->EnableDenseLookup();
     while (true) {
       if (!ls_operator_->HoldsDelta()) {
         delta->Clear();
@@ -4426,7 +4714,10 @@ Decision* FindOneNeighbor::Next(Solver* const solver) {
       }
 
       bool has_neighbor = false;
-      if (!limit_->Check()) {
+      if (operator_delta_ != nullptr) {
+        has_neighbor =
+            MakeNextReplicaFilteredNeighbor(solver, delta, deltadelta);
+      } else if (!limit_->Check()) {
         solver->GetLocalSearchMonitor()->BeginMakeNextNeighbor(ls_operator_);
         has_neighbor = ls_operator_->MakeNextNeighbor(delta, deltadelta);
         solver->GetLocalSearchMonitor()->EndMakeNextNeighbor(
@@ -4562,6 +4853,83 @@ Decision* FindOneNeighbor::Next(Solver* const solver) {
   return nullptr;
 }
 
+bool FindOneNeighbor::MakeNextReplicaFilteredNeighbor(Solver* solver,
+                                                      Assignment* delta,
+                                                      Assignment* deltadelta) {
+  // Enough candidates to keep replicas busy even if some reject quickly.
+  const int kCandidatesPerReplica = 4;
+  const int batch_size = kCandidatesPerReplica * filter_manager_->NumReplicas();
+  LocalSearchMonitor* const monitor = solver->GetLocalSearchMonitor();
+  while (true) {
+    if (batch_next_ == batch_candidates_.size()) {
+      batch_candidates_.clear();
+      batch_next_ = 0;
+      // If the operator or the limit stopped the previous batch, report it
+      // before calling the operator again, as Next() would have.
+      if (batch_is_last_) {
+        batch_is_last_ = false;
+        return false;
+      }
+      batch_is_last_ = true;
+      while (!limit_->Check()) {
+        if (!ls_operator_->HoldsDelta()) {
+          operator_delta_->Clear();
+        }
+        operator_delta_->ClearObjective();
+        operator_deltadelta_->Clear();
+        monitor->BeginMakeNextNeighbor(ls_operator_);
+        const bool has_neighbor = ls_operator_->MakeNextNeighbor(
+            operator_delta_, operator_deltadelta_);
+        monitor->EndMakeNextNeighbor(ls_operator_, has_neighbor,
+                                     operator_delta_, operator_deltadelta_);
+        if (!has_neighbor) break;
+        if (batch_deltas_.size() == batch_candidates_.size()) {
+          batch_deltas_.push_back(std::make_unique<Assignment>(solver));
+          batch_deltas_.back()->MutableIntVarContainer()->EnableDenseLookup();
+        }
+        Assignment* const candidate =
+            batch_deltas_[batch_candidates_.size()].get();
+        candidate->Copy(operator_delta_);
+        int64_t objective_min = std::numeric_limits<int64_t>::min();
+        int64_t objective_max = std::numeric_limits<int64_t>::max();
+        if (objective_) {
+          objective_min = objective_->Min();
+          objective_max = objective_->Max();
+        }
+        if (candidate->HasObjective() && candidate->Objective() == objective_) {
+          objective_min = std::max(objective_min, candidate->ObjectiveMin());
+          objective_max = std::min(objective_max, candidate->ObjectiveMax());
+        }
+        batch_candidates_.push_back({candidate, objective_min, objective_max});
+        if (batch_candidates_.size() == batch_size) {
+          batch_is_last_ = false;
+          break;
+        }
+      }
+      if (batch_candidates_.empty()) {
+        batch_is_last_ = false;
+        return false;
+      }
+    }
+    const int first_accepted =
+        batch_next_ +
+        filter_manager_->AcceptFirst(
+            absl::MakeConstSpan(batch_candidates_).subspan(batch_next_),
+            empty_deltadelta_);
+    // Neighbors accepted by replicas are counted when filtered by Next().
+    solver->neighbors_ += first_accepted - batch_next_;
+    batch_next_ = first_accepted;
+    if (first_accepted == batch_candidates_.size()) continue;
+    ++batch_next_;
+    // The candidate is filtered again by the filter manager and the
+    // metaheuristic; deltadelta is empty since the previous neighbor filtered
+    // was not necessarily the previous one made by the operator.
+    delta->Copy(batch_candidates_[first_accepted].delta);
+    deltadelta->Clear();
+    return true;
+  }
+}
+
 bool FindOneNeighbor::FilterAccept(Solver* solver, Assignment* delta,
                                    Assignment* deltadelta,
                                    int64_t objective_min,
@@ -4603,6 +4971,9 @@ void FindOneNeighbor::SynchronizeAll(Solver* solver) {
   Assignment* const reference_assignment = reference_assignment_.get();
   pool_->GetNextSolution(reference_assignment);
   neighbor_found_ = false;
+  batch_candidates_.clear();
+  batch_next_ = 0;
+  batch_is_last_ = false;
   limit_->Init();
   solver->GetLocalSearchMonitor()->BeginOperatorStart();
   ls_operator_->Start(reference_assignment);
@@ -1088,6 +1088,7 @@ namespace operations_research {
 // - SaveAndAdd()
 //
 // - ExportProfilingOverview()
+// - ExportProfilingFoldedStacks()
 // - CurrentlyInSolve()
 // - balancing_decision()
 // - set_fail_intercept()
@@ -1165,6 +1166,10 @@ namespace operations_research {
 %unignore ConstraintSolverParameters::set_profile_propagation;
 %unignore ConstraintSolverParameters::profile_file;
 %unignore ConstraintSolverParameters::set_profile_file;
+%unignore ConstraintSolverParameters::profile_sampling_period;
+%unignore ConstraintSolverParameters::set_profile_sampling_period;
+%unignore ConstraintSolverParameters::profile_folded_stacks_file;
+%unignore ConstraintSolverParameters::set_profile_folded_stacks_file;
 %unignore ConstraintSolverParameters::trace_propagation;
 %unignore ConstraintSolverParameters::set_trace_propagation;
 %unignore ConstraintSolverParameters::trace_search;
@@ -15,6 +15,7 @@
 
 from functools import partial
 
+import math
 import unittest
 
 from ortools.constraint_solver import routing_enums_pb2
@@ -625,6 +626,23 @@ class TestRoutingModel(unittest.TestCase):
         self.assertIsInstance(profile, str)
         self.assertTrue(profile)  # Verify it's not empty.
 
+    def testRoutingPropagationProfileSampling(self):
+        # Sampling demon runs in the profiler must not change the search.
+        parameters = pywrapcp.DefaultRoutingModelParameters()
+        parameters.solver_parameters.profile_propagation = True
+        parameters.solver_parameters.profile_sampling_period = 7
+        manager = pywrapcp.RoutingIndexManager(10, 1, 0)
+        model = pywrapcp.RoutingModel(manager, parameters)
+        transit_idx = model.RegisterTransitCallback(
+            partial(TransitDistance, manager))
+        model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+        search_parameters = pywrapcp.DefaultRoutingSearchParameters()
+        search_parameters.first_solution_strategy = (
+            routing_enums_pb2.FirstSolutionStrategy.FIRST_UNBOUND_MIN_VALUE)
+        assignment = model.SolveWithParameters(search_parameters)
+        self.assertEqual(model.ROUTING_SUCCESS, model.status())
+        self.assertEqual(90, assignment.ObjectiveValue())
+
     def testRoutingSearchParameters(self):
         manager = pywrapcp.RoutingIndexManager(10, 1, 0)
         self.assertIsNotNone(manager)
@@ -766,6 +784,109 @@ class TestRoutingModel(unittest.TestCase):
             routing_enums_pb2.FirstSolutionStrategy.PARALLEL_CHEAPEST_INSERTION,
             model.GetAutomaticFirstSolutionStrategy())
 
+    def testStringRemovalLNS(self):
+        manager = pywrapcp.RoutingIndexManager(21, 3, 0)
+        model = pywrapcp.RoutingModel(manager)
+        transit_idx = model.RegisterTransitCallback(
+            partial(TransitDistance, manager))
+        model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+        self.assertTrue(
+            model.AddDimension(transit_idx, 0, 1000, True, 'distance'))
+        distance_dimension = model.GetDimensionOrDie('distance')
+        pairs = [(2 * i + 1, 2 * i + 2) for i in range(10)]
+        for pickup, delivery in pairs:
+            pickup_index = manager.NodeToIndex(pickup)
+            delivery_index = manager.NodeToIndex(delivery)
+            model.AddPickupAndDelivery(pickup_index, delivery_index)
+            model.solver().Add(
+                model.VehicleVar(pickup_index) == model.VehicleVar(
+                    delivery_index))
+            model.solver().Add(
+                distance_dimension.CumulVar(pickup_index) <=
+                distance_dimension.CumulVar(delivery_index))
+        parameters = pywrapcp.DefaultRoutingSearchParameters()
+        parameters.first_solution_strategy = (
+            routing_enums_pb2.FirstSolutionStrategy.PARALLEL_CHEAPEST_INSERTION)
+        operators = parameters.local_search_operators
+        operators.use_global_cheapest_insertion_string_removal_lns = (
+            pywrapcp.BOOL_TRUE)
+        operators.use_local_cheapest_insertion_string_removal_lns = (
+            pywrapcp.BOOL_TRUE)
+        parameters.heuristic_string_removal_lns_average_num_removed_nodes = 4
+        parameters.heuristic_string_removal_lns_max_string_size = 3
+        parameters.solution_limit = 50
+        assignment = model.SolveWithParameters(parameters)
+        self.assertIsNotNone(assignment)
+        self.assertEqual(model.ROUTING_SUCCESS, model.status())
+        # Pickups and deliveries removed together are reinserted together.
+        for pickup, delivery in pairs:
+            pickup_index = manager.NodeToIndex(pickup)
+            delivery_index = manager.NodeToIndex(delivery)
+            self.assertEqual(
+                assignment.Value(model.VehicleVar(pickup_index)),
+                assignment.Value(model.VehicleVar(delivery_index)))
+            self.assertLessEqual(
+                assignment.Value(distance_dimension.CumulVar(pickup_index)),
+                assignment.Value(distance_dimension.CumulVar(delivery_index)))
+
+    def testLocalSearchFilterReplicas(self):
+        # The nodes lie on a circle, in shuffled order: the only local optimum
+        # of two-opt is the tour along the circle, whatever the order in which
+        # the neighbors are explored.
+        num_nodes = 12
+        position = [0, 7, 3, 10, 1, 5, 11, 2, 8, 4, 9, 6]
+        points = [(1000 * math.cos(2 * math.pi * p / num_nodes),
+                   1000 * math.sin(2 * math.pi * p / num_nodes))
+                  for p in position]
+        matrix = [[round(math.dist(a, b)) for b in points] for a in points]
+        node_at = {p: node for node, p in enumerate(position)}
+        circle_length = sum(matrix[node_at[p]][node_at[(p + 1) % num_nodes]]
+                            for p in range(num_nodes))
+
+        def Solve(num_replicas, use_matrix):
+            manager = pywrapcp.RoutingIndexManager(num_nodes, 1, 0)
+            model = pywrapcp.RoutingModel(manager)
+            if use_matrix:
+                transit_idx = model.RegisterTransitMatrix(matrix)
+            else:
+                # Not cached, so the replicas are not used.
+                transit_idx = model.RegisterTransitCallback(
+                    lambda i, j: matrix[manager.IndexToNode(i)][
+                        manager.IndexToNode(j)])
+            model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+            self.assertTrue(
+                model.AddDimension(transit_idx, 0, 100000, True, 'distance'))
+            search_parameters = pywrapcp.DefaultRoutingSearchParameters()
+            search_parameters.num_local_search_filter_replicas = num_replicas
+            assignment = model.SolveWithParameters(search_parameters)
+            self.assertEqual(model.ROUTING_SUCCESS, model.status())
+            return assignment.ObjectiveValue()
+
+        self.assertEqual(circle_length, Solve(0, True))
+        self.assertEqual(circle_length, Solve(3, True))
+        self.assertEqual(circle_length, Solve(3, False))
+
+    def testGuidedLocalSearchNumNeighbors(self):
+        # The penalties are the same whatever their storage, so are the
+        # solutions found.
+
+        def Solve(num_neighbors):
+            manager = pywrapcp.RoutingIndexManager(20, 2, 0)
+            model = pywrapcp.RoutingModel(manager)
+            transit_idx = model.RegisterTransitMatrix(
+                [[(7 * i + 11 * j) % 23 for j in range(20)] for i in range(20)])
+            model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+            search_parameters = pywrapcp.DefaultRoutingSearchParameters()
+            search_parameters.local_search_metaheuristic = (
+                routing_enums_pb2.LocalSearchMetaheuristic.GUIDED_LOCAL_SEARCH)
+            search_parameters.guided_local_search_num_neighbors = num_neighbors
+            search_parameters.solution_limit = 100
+            assignment = model.SolveWithParameters(search_parameters)
+            self.assertIsNotNone(assignment)
+            return assignment.ObjectiveValue()
+
+        self.assertEqual(Solve(0), Solve(5))
+
 
 class TestBoundCost(unittest.TestCase):
 
@@ -41,6 +41,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "ortools/base/dump_vars.h"
@@ -1263,11 +1264,13 @@ int RegisterUnaryCallback(RoutingTransitCallback1 callback, bool is_positive,
 int RoutingModel::RegisterUnaryTransitVector(std::vector<int64_t> values) {
   bool is_positive = std::all_of(std::cbegin(values), std::cend(values),
                                  [](int64_t transit) { return transit >= 0; });
-  return RegisterUnaryCallback(
+  const int index = RegisterUnaryCallback(
       [this, values = std::move(values)](int64_t i) {
         return values[manager_.IndexToNode(i).value()];
       },
       is_positive, this);
+  is_transit_evaluator_thread_safe_[index] = true;
+  return index;
 }
 
 int RoutingModel::RegisterUnaryTransitCallback(TransitCallback1 callback) {
@@ -1289,12 +1292,14 @@ int RoutingModel::RegisterTransitMatrix(
       break;
     }
   }
-  return RegisterCallback(
+  const int index = RegisterCallback(
       [this, values = std::move(values)](int64_t i, int64_t j) {
         return values[manager_.IndexToNode(i).value()]
                      [manager_.IndexToNode(j).value()];
       },
       all_transits_positive, this);
+  is_transit_evaluator_thread_safe_[index] = true;
+  return index;
 }
 
 int RoutingModel::RegisterPositiveUnaryTransitCallback(
@@ -1328,6 +1333,10 @@ int RoutingModel::RegisterTransitCallback(TransitCallback2 callback) {
               is_transit_evaluator_positive_.size() + 1);
     is_transit_evaluator_positive_.push_back(false);
   }
+  // A cached callback is only called here, but a unary callback is also called
+  // directly through UnaryTransitCallbackOrNull().
+  is_transit_evaluator_thread_safe_.push_back(
+      cache_callbacks_ && unary_transit_evaluators_.back() == nullptr);
   return transit_evaluators_.size() - 1;
 }
 
@@ -1447,6 +1456,7 @@ std::pair<int, bool> RoutingModel::AddConstantDimensionWithSlack(
   const int evaluator_index =
       RegisterUnaryCallback([value](int64_t) { return value; },
                             /*is_positive=*/value >= 0, this);
+  is_transit_evaluator_thread_safe_[evaluator_index] = true;
   return std::make_pair(evaluator_index,
                         AddDimension(evaluator_index, slack_max, capacity,
                                      fix_start_cumul_to_zero, dimension_name));
@@ -4827,6 +4837,18 @@ void RoutingModel::CreateNeighborhoodOperators(
           make_local_cheapest_insertion_filtered_heuristic(),
           parameters.heuristic_close_nodes_lns_num_nodes()));
 
+  local_search_operators_[GLOBAL_CHEAPEST_INSERTION_STRING_REMOVAL_LNS] =
+      solver_->RevAlloc(new FilteredHeuristicStringRemovalLNSOperator(
+          make_global_cheapest_insertion_filtered_heuristic(),
+          parameters.heuristic_string_removal_lns_average_num_removed_nodes(),
+          parameters.heuristic_string_removal_lns_max_string_size()));
+
+  local_search_operators_[LOCAL_CHEAPEST_INSERTION_STRING_REMOVAL_LNS] =
+      solver_->RevAlloc(new FilteredHeuristicStringRemovalLNSOperator(
+          make_local_cheapest_insertion_filtered_heuristic(),
+          parameters.heuristic_string_removal_lns_average_num_removed_nodes(),
+          parameters.heuristic_string_removal_lns_max_string_size()));
+
   local_search_operators_[GLOBAL_CHEAPEST_INSERTION_PATH_LNS] =
       solver_->RevAlloc(new FilteredHeuristicPathLNSOperator(
           make_global_cheapest_insertion_filtered_heuristic()));
@@ -4852,6 +4874,63 @@ void RoutingModel::CreateNeighborhoodOperators(
           make_local_cheapest_insertion_filtered_heuristic(),
           parameters.heuristic_expensive_chain_lns_num_arcs_to_consider(),
           arc_cost_for_path_start));
+
+  if (parameters.granular_neighborhood_num_neighbors() > 0) {
+    SetArcCandidatesOfPathOperators(
+        parameters.granular_neighborhood_num_neighbors());
+  }
+}
+
+std::vector<std::vector<int64_t>> RoutingModel::GetNeighborCandidates(
+    int num_neighbors) {
+  const NodeNeighborsByCostClass* const node_neighbors =
+      GetOrCreateNodeNeighborsByCostClass(num_neighbors);
+  std::vector<std::vector<int64_t>> candidates(Size());
+  for (int node = 0; node < Size(); ++node) {
+    for (int cost_class = 0; cost_class < GetCostClassesCount(); ++cost_class) {
+      if (!HasVehicleWithCostClassIndex(CostClassIndex(cost_class))) continue;
+      for (const int neighbor :
+           node_neighbors->GetNeighborsOfNodeForCostClass(cost_class, node)) {
+        candidates[node].push_back(neighbor);
+      }
+    }
+  }
+  return candidates;
+}
+
+void RoutingModel::SetArcCandidatesOfPathOperators(int num_neighbors) {
+  arc_candidates_ =
+      std::make_unique<ArcCandidates>(GetNeighborCandidates(num_neighbors));
+  // LNS and TSP operators rebuild whole paths and are left unrestricted.
+  // Relocate (multi-path), Exchange and TwoOpt only enumerate arc candidates;
+  // the neighbors of the other path operators are enumerated and filtered.
+  // Operators which are not path operators (concatenations of operators such
+  // as OrOpt for instance) are not restricted.
+  std::vector<std::string> enumerated;
+  std::vector<std::string> filtered;
+  std::vector<std::string> unrestricted;
+  for (const RoutingLocalSearchOperator type :
+       {RELOCATE, RELOCATE_PAIR, LIGHT_RELOCATE_PAIR, RELOCATE_NEIGHBORS,
+        EXCHANGE, CROSS, TWO_OPT, OR_OPT, RELOCATE_EXPENSIVE_CHAIN,
+        MAKE_ACTIVE, RELOCATE_AND_MAKE_ACTIVE, MAKE_ACTIVE_AND_RELOCATE,
+        SWAP_ACTIVE, EXTENDED_SWAP_ACTIVE, EXCHANGE_RELOCATE_PAIR,
+        RELOCATE_SUBTRIP, EXCHANGE_SUBTRIP}) {
+    LocalSearchOperator* const local_search_operator =
+        local_search_operators_[type];
+    PathOperator* const path_operator =
+        dynamic_cast<PathOperator*>(local_search_operator);
+    if (path_operator == nullptr) {
+      unrestricted.push_back(local_search_operator->DebugString());
+      continue;
+    }
+    path_operator->SetArcCandidates(arc_candidates_.get());
+    (path_operator->HasNeighbors() ? enumerated : filtered)
+        .push_back(path_operator->DebugString());
+  }
+  VLOG(1) << "Granular neighborhoods with " << num_neighbors
+          << " neighbors. Enumerated: " << absl::StrJoin(enumerated, ", ")
+          << ". Filtered: " << absl::StrJoin(filtered, ", ")
+          << ". Not restricted: " << absl::StrJoin(unrestricted, ", ") << ".";
 }
 
 #define CP_ROUTING_PUSH_OPERATOR(operator_type, operator_method, operators) \
@@ -4968,6 +5047,12 @@ LocalSearchOperator* RoutingModel::GetNeighborhoodOperators(
                            operators);
   CP_ROUTING_PUSH_OPERATOR(LOCAL_CHEAPEST_INSERTION_CLOSE_NODES_LNS,
                            local_cheapest_insertion_close_nodes_lns, operators);
+  CP_ROUTING_PUSH_OPERATOR(GLOBAL_CHEAPEST_INSERTION_STRING_REMOVAL_LNS,
+                           global_cheapest_insertion_string_removal_lns,
+                           operators);
+  CP_ROUTING_PUSH_OPERATOR(LOCAL_CHEAPEST_INSERTION_STRING_REMOVAL_LNS,
+                           local_cheapest_insertion_string_removal_lns,
+                           operators);
   operator_groups.push_back(ConcatenateOperators(search_parameters, operators));
 
   // Third local search loop: Expensive LNS operators.
@@ -5125,6 +5210,9 @@ RoutingModel::CreateLocalSearchFilters(
         {MakeTypeRegulationsFilter(*this), kAccept, priority});
   }
 
+  // Filters below share state with other filter instances.
+  if (options.thread_safe_only) return filter_events;
+
   {
     ++priority;
     const int first_dimension_filter_index = filter_events.size();
@@ -5172,9 +5260,43 @@ LocalSearchFilterManager* RoutingModel::GetOrCreateLocalSearchFilterManager(
             CreateLocalSearchFilters(parameters, options)));
     local_search_filter_managers_[options] = local_search_filter_manager;
   }
+  local_search_filter_manager->SetAdaptiveOrdering(
+      parameters.use_adaptive_filter_ordering());
   return local_search_filter_manager;
 }
 
+void RoutingModel::SetLocalSearchFilterReplicas(
+    const RoutingSearchParameters& parameters,
+    LocalSearchFilterManager* filter_manager) {
+  const int num_replicas = parameters.num_local_search_filter_replicas();
+  if (num_replicas == 0 || filter_manager->NumReplicas() > 0) return;
+  // The dimension filters of the replicas call the transit callbacks
+  // concurrently, which is only safe for the callbacks known to be
+  // thread-safe; the others might for instance be Python functions.
+  for (const RoutingDimension* dimension : dimensions_) {
+    for (const int evaluator : dimension->class_evaluators_) {
+      if (!is_transit_evaluator_thread_safe_[evaluator]) {
+        LOG(WARNING) << "Ignoring num_local_search_filter_replicas: the "
+                        "transit callbacks of dimension "
+                     << dimension->name() << " might not be thread-safe.";
+        return;
+      }
+    }
+  }
+  // The objective is not filtered by the replicas: the cost callbacks of the
+  // model cache their values and cannot be called concurrently.
+  std::vector<LocalSearchFilterManager*> replicas;
+  replicas.reserve(num_replicas);
+  for (int r = 0; r < num_replicas; ++r) {
+    replicas.push_back(solver_->RevAlloc(
+        new LocalSearchFilterManager(CreateLocalSearchFilters(
+            parameters, {/*filter_objective=*/false,
+                         /*filter_with_cp_solver=*/false,
+                         /*thread_safe_only=*/true}))));
+  }
+  filter_manager->SetReplicas(std::move(replicas));
+}
+
 namespace {
 bool AllTransitsPositive(const RoutingDimension& dimension) {
   for (int vehicle = 0; vehicle < dimension.model()->vehicles(); vehicle++) {
@@ -5808,14 +5930,16 @@ RoutingModel::CreateIntVarFilteredDecisionBuilder(const Args&... args) {
 LocalSearchPhaseParameters* RoutingModel::CreateLocalSearchParameters(
     const RoutingSearchParameters& search_parameters) {
   SearchLimit* lns_limit = GetOrCreateLargeNeighborhoodSearchLimit();
+  LocalSearchFilterManager* const filter_manager =
+      GetOrCreateLocalSearchFilterManager(
+          search_parameters,
+          {/*filter_objective=*/true, /*filter_with_cp_solver=*/false});
+  SetLocalSearchFilterReplicas(search_parameters, filter_manager);
   return solver_->MakeLocalSearchPhaseParameters(
       CostVar(), GetNeighborhoodOperators(search_parameters),
       solver_->MakeSolveOnce(
           CreateSolutionFinalizer(search_parameters, lns_limit), lns_limit),
-      GetOrCreateLocalSearchLimit(),
-      GetOrCreateLocalSearchFilterManager(
-          search_parameters,
-          {/*filter_objective=*/true, /*filter_with_cp_solver=*/false}));
+      GetOrCreateLocalSearchLimit(), filter_manager);
 }
 
 DecisionBuilder* RoutingModel::CreateLocalSearchDecisionBuilder(
@@ -5897,7 +6021,30 @@ void RoutingModel::SetupMetaheuristics(
       MathUtil::FastInt64Round(search_parameters.optimization_step()), One());
   switch (metaheuristic) {
     case LocalSearchMetaheuristic::GUIDED_LOCAL_SEARCH:
-      if (CostsAreHomogeneousAcrossVehicles()) {
+      if (search_parameters.guided_local_search_num_neighbors() > 0) {
+        const std::vector<std::vector<int64_t>> candidates =
+            GetNeighborCandidates(
+                search_parameters.guided_local_search_num_neighbors());
+        if (CostsAreHomogeneousAcrossVehicles()) {
+          optimize = solver_->MakeGuidedLocalSearchWithCandidates(
+              false, cost_,
+              [this](int64_t i, int64_t j) { return GetHomogeneousCost(i, j); },
+              optimization_step, nexts_, candidates,
+              search_parameters.guided_local_search_lambda_coefficient(),
+              search_parameters
+                  .guided_local_search_reset_penalties_on_new_best_solution());
+        } else {
+          optimize = solver_->MakeGuidedLocalSearchWithCandidates(
+              false, cost_,
+              [this](int64_t i, int64_t j, int64_t k) {
+                return GetArcCostForVehicle(i, j, k);
+              },
+              optimization_step, nexts_, vehicle_vars_, candidates,
+              search_parameters.guided_local_search_lambda_coefficient(),
+              search_parameters
+                  .guided_local_search_reset_penalties_on_new_best_solution());
+        }
+      } else if (CostsAreHomogeneousAcrossVehicles()) {
         optimize = solver_->MakeGuidedLocalSearch(
             false, cost_,
             [this](int64_t i, int64_t j) { return GetHomogeneousCost(i, j); },
@@ -1746,6 +1746,8 @@ class RoutingModel {
     RELOCATE_PATH_GLOBAL_CHEAPEST_INSERTION_INSERT_UNPERFORMED,
     GLOBAL_CHEAPEST_INSERTION_EXPENSIVE_CHAIN_LNS,
     LOCAL_CHEAPEST_INSERTION_EXPENSIVE_CHAIN_LNS,
+    GLOBAL_CHEAPEST_INSERTION_STRING_REMOVAL_LNS,
+    LOCAL_CHEAPEST_INSERTION_STRING_REMOVAL_LNS,
     RELOCATE_EXPENSIVE_CHAIN,
     LIN_KERNIGHAN,
     TSP_OPT,
@@ -1993,6 +1995,14 @@ class RoutingModel {
     return CreateOperator<T>(pickup_delivery_pairs_);
   }
   void CreateNeighborhoodOperators(const RoutingSearchParameters& parameters);
+  /// Restricts the arc-exchange path operators to neighbors adding an arc
+  /// between a node and one of its num_neighbors closest nodes. Logs which
+  /// operators only enumerate these neighbors, which ones filter them, and
+  /// which ones are not restricted.
+  void SetArcCandidatesOfPathOperators(int num_neighbors);
+  /// Returns, for each node, its num_neighbors closest nodes for all cost
+  /// classes used by a vehicle.
+  std::vector<std::vector<int64_t>> GetNeighborCandidates(int num_neighbors);
   LocalSearchOperator* ConcatenateOperators(
       const RoutingSearchParameters& search_parameters,
       const std::vector<LocalSearchOperator*>& operators) const;
@@ -2002,21 +2012,35 @@ class RoutingModel {
   struct FilterOptions {
     bool filter_objective;
     bool filter_with_cp_solver;
+    // If true, only the filters whose Accept() can be called concurrently with
+    // the one of other filter instances are created: the dimension cumul
+    // filters (sharing the cumul optimizers of the model), the break filters,
+    // the extra filters and the CP feasibility filter are left out.
+    bool thread_safe_only = false;
 
     bool operator==(const FilterOptions& other) const {
       return other.filter_objective == filter_objective &&
-             other.filter_with_cp_solver == filter_with_cp_solver;
+             other.filter_with_cp_solver == filter_with_cp_solver &&
+             other.thread_safe_only == thread_safe_only;
     }
     template <typename H>
     friend H AbslHashValue(H h, const FilterOptions& options) {
       return H::combine(std::move(h), options.filter_objective,
-                        options.filter_with_cp_solver);
+                        options.filter_with_cp_solver,
+                        options.thread_safe_only);
     }
   };
   std::vector<LocalSearchFilterManager::FilterEvent> CreateLocalSearchFilters(
       const RoutingSearchParameters& parameters, const FilterOptions& options);
   LocalSearchFilterManager* GetOrCreateLocalSearchFilterManager(
       const RoutingSearchParameters& parameters, const FilterOptions& options);
+  // Gives num_local_search_filter_replicas replicas to the given filter
+  // manager, if it has none yet and the transit callbacks of all dimensions are
+  // thread-safe. The replicas only hold the thread-safe feasibility filters
+  // (see FilterOptions::thread_safe_only): they prefilter the neighbors that
+  // are then filtered again by the full filter manager.
+  void SetLocalSearchFilterReplicas(const RoutingSearchParameters& parameters,
+                                    LocalSearchFilterManager* filter_manager);
   DecisionBuilder* CreateSolutionFinalizer(
       const RoutingSearchParameters& parameters, SearchLimit* lns_limit);
   DecisionBuilder* CreateFinalizerForMinimizedAndMaximizedVariables();
@@ -2268,6 +2292,9 @@ class RoutingModel {
   std::vector<LocalSearchFilterManager::FilterEvent> extra_filters_;
   absl::flat_hash_map<int, std::unique_ptr<NodeNeighborsByCostClass>>
       node_neighbors_by_cost_class_per_size_;
+#ifndef SWIG
+  std::unique_ptr<ArcCandidates> arc_candidates_;
+#endif  // SWIG
 #ifndef SWIG
   struct VarTarget {
     VarTarget(IntVar* v, int64_t t) : var(v), target(t) {}
@@ -2307,6 +2334,12 @@ class RoutingModel {
   // allow some improvements in the solver, but will entail in errors if the
   // transits are falsely assumed positive.
   std::vector<bool> is_transit_evaluator_positive_;
+  // Whether each transit_evaluator_ can be called from several threads: true
+  // for the callbacks cached at registration (see
+  // RoutingModelParameters.max_callback_cache_size) and for the ones built by
+  // the model from vectors, matrices or constants, false for the other user
+  // callbacks.
+  std::vector<bool> is_transit_evaluator_thread_safe_;
   std::vector<VariableIndexEvaluator2> state_dependent_transit_evaluators_;
   std::vector<std::unique_ptr<StateDependentTransitCallbackCache>>
       state_dependent_transit_evaluators_cache_;
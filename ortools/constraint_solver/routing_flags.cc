@@ -114,6 +114,9 @@ ABSL_FLAG(int, routing_number_of_solutions_to_collect, 1,
 ABSL_FLAG(int, routing_relocate_expensive_chain_num_arcs_to_consider, 4,
           "Number of arcs to consider in the RelocateExpensiveChain "
           "neighborhood operator.");
+ABSL_FLAG(int, routing_granular_neighborhood_num_neighbors, 0,
+          "If positive, restricts arc-exchange neighborhood operators to "
+          "neighbors adding an arc to one of the closest nodes of a node.");
 
 // Propagation control
 ABSL_FLAG(bool, routing_use_light_propagation, true,
@@ -232,6 +235,10 @@ void AddLocalSearchNeighborhoodOperatorsFromFlags(
       BOOL_FALSE);
   local_search_operators->set_use_local_cheapest_insertion_close_nodes_lns(
       BOOL_FALSE);
+  local_search_operators->set_use_global_cheapest_insertion_string_removal_lns(
+      BOOL_FALSE);
+  local_search_operators->set_use_local_cheapest_insertion_string_removal_lns(
+      BOOL_FALSE);
 
   local_search_operators->set_use_relocate(
       ToOptionalBoolean(!absl::GetFlag(FLAGS_routing_no_relocate)));
@@ -313,6 +320,10 @@ void SetMiscellaneousParametersFromFlags(RoutingSearchParameters* parameters) {
       FLAGS_routing_relocate_expensive_chain_num_arcs_to_consider));
   parameters->set_heuristic_expensive_chain_lns_num_arcs_to_consider(4);
   parameters->set_heuristic_close_nodes_lns_num_nodes(5);
+  parameters->set_heuristic_string_removal_lns_average_num_removed_nodes(10);
+  parameters->set_heuristic_string_removal_lns_max_string_size(10);
+  parameters->set_granular_neighborhood_num_neighbors(
+      absl::GetFlag(FLAGS_routing_granular_neighborhood_num_neighbors));
   parameters->set_continuous_scheduling_solver(
       RoutingSearchParameters::SCHEDULING_GLOP);
   parameters->set_mixed_integer_scheduling_solver(
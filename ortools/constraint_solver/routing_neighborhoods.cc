@@ -1245,6 +1245,194 @@ FilteredHeuristicCloseNodesLNSOperator::SetupNextAccessorForNeighbor() {
   return [this](int64_t node) { return Next(node); };
 }
 
+// FilteredHeuristicStringRemovalLNSOperator
+
+FilteredHeuristicStringRemovalLNSOperator::
+    FilteredHeuristicStringRemovalLNSOperator(
+        std::unique_ptr<RoutingFilteredHeuristic> heuristic,
+        int average_num_removed_nodes, int max_string_size)
+    : FilteredHeuristicLocalSearchOperator(std::move(heuristic)),
+      pickup_delivery_pairs_(model_->GetPickupAndDeliveryPairs()),
+      average_num_removed_nodes_(average_num_removed_nodes),
+      max_string_size_(max_string_size),
+      initialized_(false),
+      num_neighbors_since_start_(0),
+      rand_(0),
+      route_of_node_(model_->Size(), -1),
+      position_of_node_(model_->Size(), -1),
+      ruined_routes_(model_->vehicles()) {
+  DCHECK_GE(average_num_removed_nodes_, 1);
+  DCHECK_GE(max_string_size_, 1);
+}
+
+void FilteredHeuristicStringRemovalLNSOperator::Initialize() {
+  if (initialized_) return;
+  initialized_ = true;
+  const int64_t size = model_->Size();
+  // Nodes further than these are very unlikely to be reached before the
+  // drawn number of routes has been ruined.
+  const int64_t num_closest_nodes = std::min<int64_t>(
+      4 * average_num_removed_nodes_,
+      std::max<int64_t>(0, size - 1 - model_->vehicles()));
+  close_nodes_.resize(size);
+  if (num_closest_nodes == 0) return;
+
+  // The close nodes are taken among the neighbors shared with the other
+  // neighbor-based heuristics and operators, and only these are sorted.
+  const RoutingModel::NodeNeighborsByCostClass* const node_neighbors =
+      model_->GetOrCreateNodeNeighborsByCostClass(num_closest_nodes);
+  const int64_t num_cost_classes = model_->GetCostClassesCount();
+  SparseBitset<int64_t> is_candidate(size);
+  std::vector<std::pair</*cost*/ double, /*node*/ int64_t>> costed_after_nodes;
+  for (int64_t node = 0; node < size; node++) {
+    if (model_->IsStart(node)) continue;
+    is_candidate.SparseClearAll();
+    costed_after_nodes.clear();
+    for (int cost_class = 0; cost_class < num_cost_classes; cost_class++) {
+      if (!model_->HasVehicleWithCostClassIndex(
+              RoutingCostClassIndex(cost_class))) {
+        continue;
+      }
+      for (const int after_node :
+           node_neighbors->GetNeighborsOfNodeForCostClass(cost_class, node)) {
+        if (model_->IsStart(after_node) || after_node == node ||
+            is_candidate[after_node]) {
+          continue;
+        }
+        is_candidate.Set(after_node);
+        double total_cost = 0.0;
+        // NOTE: We don't consider the 'always-zero' cost class when searching
+        // for closest nodes.
+        for (int cc = 1; cc < num_cost_classes; cc++) {
+          total_cost += model_->GetArcCostForClass(node, after_node, cc);
+        }
+        costed_after_nodes.emplace_back(total_cost, after_node);
+      }
+    }
+    const int num_nodes =
+        std::min<int64_t>(num_closest_nodes, costed_after_nodes.size());
+    std::partial_sort(costed_after_nodes.begin(),
+                      costed_after_nodes.begin() + num_nodes,
+                      costed_after_nodes.end());
+    std::vector<int64_t>& closest_nodes = close_nodes_[node];
+    closest_nodes.reserve(num_nodes);
+    for (int index = 0; index < num_nodes; index++) {
+      closest_nodes.push_back(costed_after_nodes[index].second);
+    }
+  }
+}
+
+void FilteredHeuristicStringRemovalLNSOperator::OnStart() {
+  Initialize();
+  num_neighbors_since_start_ = 0;
+  routes_.resize(model_->vehicles());
+  performed_nodes_.clear();
+  std::fill(route_of_node_.begin(), route_of_node_.end(), -1);
+  std::fill(position_of_node_.begin(), position_of_node_.end(), -1);
+  for (int vehicle = 0; vehicle < model_->vehicles(); vehicle++) {
+    std::vector<int64_t>& route = routes_[vehicle];
+    route.clear();
+    for (int64_t node = OldValue(model_->Start(vehicle)); !model_->IsEnd(node);
+         node = OldValue(node)) {
+      route_of_node_[node] = vehicle;
+      position_of_node_[node] = route.size();
+      route.push_back(node);
+      performed_nodes_.push_back(node);
+    }
+  }
+}
+
+bool FilteredHeuristicStringRemovalLNSOperator::IncrementPosition() {
+  DCHECK(initialized_);
+  // Neighbors are drawn at random; as many are tried as there are nodes, like
+  // the other node-based LNS operators.
+  return !performed_nodes_.empty() &&
+         num_neighbors_since_start_++ < model_->Size();
+}
+
+void FilteredHeuristicStringRemovalLNSOperator::RemoveNodeAndActiveSiblings(
+    int64_t node) {
+  if (removed_nodes_[node] || Value(node) == node) return;
+  removed_nodes_.Set(node);
+  // NOTE: In most use-cases, where each node is a pickup or delivery in a
+  // single index pair, this is in O(k) where k is the number of alternative
+  // deliveries or pickups for this index pair.
+  for (const auto& index_pair : model_->GetPickupIndexPairs(node)) {
+    for (int64_t delivery : pickup_delivery_pairs_[index_pair.first].second) {
+      if (Value(delivery) != delivery) removed_nodes_.Set(delivery);
+    }
+  }
+  for (const auto& index_pair : model_->GetDeliveryIndexPairs(node)) {
+    for (int64_t pickup : pickup_delivery_pairs_[index_pair.first].first) {
+      if (Value(pickup) != pickup) removed_nodes_.Set(pickup);
+    }
+  }
+}
+
+void FilteredHeuristicStringRemovalLNSOperator::RemoveString(int route,
+                                                             int string_start,
+                                                             int string_size) {
+  const std::vector<int64_t>& nodes = routes_[route];
+  for (int position = string_start; position < string_start + string_size;
+       position++) {
+    RemoveNodeAndActiveSiblings(nodes[position]);
+  }
+}
+
+std::function<int64_t(int64_t)>
+FilteredHeuristicStringRemovalLNSOperator::SetupNextAccessorForNeighbor() {
+  DCHECK(initialized_);
+  ruined_routes_.SparseClearAll();
+
+  int num_non_empty_routes = 0;
+  for (const std::vector<int64_t>& route : routes_) {
+    if (!route.empty()) num_non_empty_routes++;
+  }
+  const double average_route_size =
+      static_cast<double>(performed_nodes_.size()) / num_non_empty_routes;
+  const double max_string_size =
+      std::min<double>(max_string_size_, average_route_size);
+  const double max_num_strings =
+      4.0 * average_num_removed_nodes_ / (1.0 + max_string_size) - 1.0;
+  const int num_strings = std::max(
+      1, static_cast<int>(std::uniform_real_distribution<double>(
+             1.0, std::max(1.0, max_num_strings) + 1.0)(rand_)));
+
+  const int64_t seed = performed_nodes_[std::uniform_int_distribution<int>(
+      0, performed_nodes_.size() - 1)(rand_)];
+  int num_ruined_routes = 0;
+  const auto ruin_route_of = [this, max_string_size,
+                              &num_ruined_routes](int64_t node) {
+    const int route = route_of_node_[node];
+    if (route < 0 || ruined_routes_[route] || removed_nodes_[node]) return;
+    ruined_routes_.Set(route);
+    num_ruined_routes++;
+    const int route_size = routes_[route].size();
+    const double max_size = std::min<double>(route_size, max_string_size);
+    const int string_size = std::min(
+        route_size, static_cast<int>(std::uniform_real_distribution<double>(
+                        1.0, max_size + 1.0)(rand_)));
+    // Draws the position of the string among the ones containing the node.
+    const int position = position_of_node_[node];
+    const int min_start = std::max(0, position - string_size + 1);
+    const int max_start = std::min(position, route_size - string_size);
+    RemoveString(
+        route, std::uniform_int_distribution<int>(min_start, max_start)(rand_),
+        string_size);
+  };
+  ruin_route_of(seed);
+  for (int64_t node : close_nodes_[seed]) {
+    if (num_ruined_routes >= num_strings) break;
+    ruin_route_of(node);
+  }
+
+  return [this](int64_t node) {
+    int64_t next = Value(node);
+    while (next < model_->Size() && removed_nodes_[next]) next = Value(next);
+    return next;
+  };
+}
+
 // FilteredHeuristicExpensiveChainLNSOperator
 
 FilteredHeuristicExpensiveChainLNSOperator::
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -637,6 +638,67 @@ class FilteredHeuristicCloseNodesLNSOperator
   SparseBitset<> changed_prevs_;
 };
 
+/// Filtered heuristic LNS operator, where the destruction phase removes strings
+/// of consecutive nodes from several routes which are close to each other, in
+/// the spirit of the "Slack Induction by String Removals" ruin of Christiaens
+/// and Vanden Berghe (2020):
+/// - a seed node is picked at random among performed nodes;
+/// - the seed and its closest nodes are scanned by increasing distance; for
+///   each one on a route which has not been ruined yet, a random string of
+///   consecutive nodes containing it is removed from its route, until the
+///   randomly chosen number of routes has been ruined.
+/// The number of strings and their size are drawn such that on average
+/// 'average_num_removed_nodes' nodes are removed, and strings are at most
+/// 'max_string_size' long (and at most as long as the average route).
+/// Performed pickup/delivery siblings of removed nodes are removed too, and all
+/// removed nodes are reinserted by the heuristic.
+class FilteredHeuristicStringRemovalLNSOperator
+    : public FilteredHeuristicLocalSearchOperator {
+ public:
+  FilteredHeuristicStringRemovalLNSOperator(
+      std::unique_ptr<RoutingFilteredHeuristic> heuristic,
+      int average_num_removed_nodes, int max_string_size);
+  ~FilteredHeuristicStringRemovalLNSOperator() override {}
+
+  std::string DebugString() const override {
+    return absl::StrCat("HeuristicStringRemovalLNS(", HeuristicName(), ")");
+  }
+
+ private:
+  void Initialize();
+
+  void OnStart() override;
+
+  bool IncrementPosition() override;
+
+  std::function<int64_t(int64_t)> SetupNextAccessorForNeighbor() override;
+
+  /// Removes the string of 'string_size' nodes of 'route' starting at position
+  /// 'string_start', along with their performed pickup/delivery siblings.
+  void RemoveString(int route, int string_start, int string_size);
+  void RemoveNodeAndActiveSiblings(int64_t node);
+
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>>&
+      pickup_delivery_pairs_;
+  const int average_num_removed_nodes_;
+  const int max_string_size_;
+
+  bool initialized_;
+  int num_neighbors_since_start_;
+  std::mt19937 rand_;
+  /// Nodes sorted by increasing distance from each node.
+  std::vector<std::vector<int64_t>> close_nodes_;
+
+  /// The routes of the solution the operator started from, with, for each
+  /// performed node, its route and position on the route (-1 if unperformed).
+  std::vector<std::vector<int64_t>> routes_;
+  std::vector<int64_t> performed_nodes_;
+  std::vector<int> route_of_node_;
+  std::vector<int> position_of_node_;
+  /// Routes ruined while making the current neighbor.
+  SparseBitset<> ruined_routes_;
+};
+
 /// RelocateExpensiveChain
 ///
 /// Operator which relocates the most expensive subchains (given a cost
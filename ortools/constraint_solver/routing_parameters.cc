@@ -105,15 +105,21 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   o->set_use_local_cheapest_insertion_expensive_chain_lns(BOOL_FALSE);
   o->set_use_global_cheapest_insertion_close_nodes_lns(BOOL_FALSE);
   o->set_use_local_cheapest_insertion_close_nodes_lns(BOOL_FALSE);
+  o->set_use_global_cheapest_insertion_string_removal_lns(BOOL_FALSE);
+  o->set_use_local_cheapest_insertion_string_removal_lns(BOOL_FALSE);
   p.set_use_multi_armed_bandit_concatenate_operators(false);
   p.set_multi_armed_bandit_compound_operator_memory_coefficient(0.04);
   p.set_multi_armed_bandit_compound_operator_exploration_coefficient(1e12);
   p.set_relocate_expensive_chain_num_arcs_to_consider(4);
   p.set_heuristic_expensive_chain_lns_num_arcs_to_consider(4);
   p.set_heuristic_close_nodes_lns_num_nodes(5);
+  p.set_heuristic_string_removal_lns_average_num_removed_nodes(10);
+  p.set_heuristic_string_removal_lns_max_string_size(10);
+  p.set_granular_neighborhood_num_neighbors(0);
   p.set_local_search_metaheuristic(LocalSearchMetaheuristic::AUTOMATIC);
   p.set_guided_local_search_lambda_coefficient(0.1);
   p.set_guided_local_search_reset_penalties_on_new_best_solution(false);
+  p.set_guided_local_search_num_neighbors(0);
   p.set_use_depth_first_search(false);
   p.set_use_cp(BOOL_TRUE);
   p.set_use_cp_sat(BOOL_FALSE);
@@ -131,6 +137,8 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_solution_limit(kint64max);
   p.mutable_lns_time_limit()->set_nanos(100000000);  // 0.1s.
   p.set_use_full_propagation(false);
+  p.set_use_adaptive_filter_ordering(false);
+  p.set_num_local_search_filter_replicas(0);
   p.set_log_search(false);
   p.set_log_cost_scaling_factor(1.0);
   p.set_log_cost_offset(0.0);
@@ -272,6 +280,33 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
         StrCat("Invalid heuristic_close_nodes_lns_num_nodes: ", num_nodes,
                ". Must be between 0 and 10000 (included)."));
   }
+  if (const int32_t num_nodes =
+          search_parameters
+              .heuristic_string_removal_lns_average_num_removed_nodes();
+      num_nodes < 1 || num_nodes > 1e4) {
+    errors.emplace_back(StrCat(
+        "Invalid heuristic_string_removal_lns_average_num_removed_nodes: ",
+        num_nodes, ". Must be between 1 and 10000 (included)."));
+  }
+  if (const int32_t string_size =
+          search_parameters.heuristic_string_removal_lns_max_string_size();
+      string_size < 1 || string_size > 1e4) {
+    errors.emplace_back(
+        StrCat("Invalid heuristic_string_removal_lns_max_string_size: ",
+               string_size, ". Must be between 1 and 10000 (included)."));
+  }
+  if (const int32_t num_replicas =
+          search_parameters.num_local_search_filter_replicas();
+      num_replicas < 0) {
+    errors.emplace_back(StrCat("Invalid num_local_search_filter_replicas: ",
+                               num_replicas, ". Must be non-negative."));
+  }
+  if (const int32_t num_neighbors =
+          search_parameters.granular_neighborhood_num_neighbors();
+      num_neighbors < 0) {
+    errors.emplace_back(StrCat("Invalid granular_neighborhood_num_neighbors: ",
+                               num_neighbors, ". Must be non-negative."));
+  }
   if (const double gls_coefficient =
           search_parameters.guided_local_search_lambda_coefficient();
       std::isnan(gls_coefficient) || gls_coefficient < 0 ||
@@ -279,6 +314,12 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
     errors.emplace_back(StrCat(
         "Invalid guided_local_search_lambda_coefficient: ", gls_coefficient));
   }
+  if (const int32_t num_neighbors =
+          search_parameters.guided_local_search_num_neighbors();
+      num_neighbors < 0) {
+    errors.emplace_back(StrCat("Invalid guided_local_search_num_neighbors: ",
+                               num_neighbors, ". Must be non-negative."));
+  }
   if (const double step = search_parameters.optimization_step();
       std::isnan(step) || step < 0.0) {
     errors.emplace_back(StrCat("Invalid optimization_step: ", step));
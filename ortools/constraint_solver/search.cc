@@ -3494,7 +3494,9 @@ namespace {
 // GLS penalty management classes. Maintains the penalty frequency for each
 // (variable, value) pair.
 
-// Dense GLS penalties implementation using a matrix to store penalties.
+// Dense GLS penalties implementation using a matrix to store penalties. Lookups,
+// done for every evaluated neighbor, are a direct access in the row of the
+// variable.
 class GuidedLocalSearchPenaltiesTable {
  public:
   struct VarValue {
@@ -3587,13 +3589,125 @@ int64_t GuidedLocalSearchPenaltiesMap::GetPenalty(
              : 0;
 }
 
+// GLS penalties implementation for variables whose penalized values are mostly
+// known in advance, such as the next variables of routing models, for which
+// the penalized arcs mostly go to close neighbors. The candidate values of each
+// variable and their penalties are stored in a flat row of the same size for
+// all variables, so that a lookup only reads a few contiguous cache lines; the
+// penalties of the other values are stored in a hash map. Memory is linear in
+// the number of candidates, and the rows are built once.
+class GuidedLocalSearchPenaltiesRows {
+ public:
+  using VarValue = GuidedLocalSearchPenaltiesMap::VarValue;
+  GuidedLocalSearchPenaltiesRows(
+      int num_vars, const std::vector<std::vector<int64_t>>& candidate_values);
+  bool HasPenalties() const { return has_values_; }
+  void IncrementPenalty(const VarValue& var_value);
+  int64_t GetPenalty(const VarValue& var_value) const;
+  void Reset();
+
+ private:
+  struct Entry {
+    int64_t value;
+    int64_t penalty;
+  };
+  // Returns the entry of the value in the row of the variable, or nullptr if
+  // it is not a candidate of the variable.
+  const Entry* FindEntry(const VarValue& var_value) const;
+
+  // The candidate values of variable var are in
+  // [var * row_size_, (var + 1) * row_size_) of entries_, rows with fewer
+  // candidates being padded with a value which is never looked up.
+  int row_size_;
+  std::vector<Entry> entries_;
+  // Whether a variable has penalized values in its row, or which are not
+  // candidates; this saves the lookups of the variables without penalties,
+  // which are most of the variables.
+  std::vector<bool> penalized_in_row_;
+  std::vector<bool> penalized_outside_row_;
+  absl::flat_hash_map<VarValue, int64_t> other_penalties_;
+  bool has_values_;
+};
+
+GuidedLocalSearchPenaltiesRows::GuidedLocalSearchPenaltiesRows(
+    int num_vars, const std::vector<std::vector<int64_t>>& candidate_values)
+    : row_size_(0),
+      penalized_in_row_(num_vars, false),
+      penalized_outside_row_(num_vars, false),
+      has_values_(false) {
+  DCHECK_LE(candidate_values.size(), num_vars);
+  std::vector<std::vector<int64_t>> rows(num_vars);
+  for (int var = 0; var < candidate_values.size(); ++var) {
+    rows[var] = candidate_values[var];
+    gtl::STLSortAndRemoveDuplicates(&rows[var]);
+    row_size_ = std::max<int>(row_size_, rows[var].size());
+  }
+  entries_.resize(static_cast<size_t>(num_vars) * row_size_,
+                  {std::numeric_limits<int64_t>::min(), 0});
+  for (int var = 0; var < num_vars; ++var) {
+    for (int i = 0; i < rows[var].size(); ++i) {
+      entries_[static_cast<size_t>(var) * row_size_ + i].value = rows[var][i];
+    }
+  }
+}
+
+const GuidedLocalSearchPenaltiesRows::Entry*
+GuidedLocalSearchPenaltiesRows::FindEntry(const VarValue& var_value) const {
+  const Entry* const row =
+      entries_.data() + static_cast<size_t>(var_value.var) * row_size_;
+  // Rows are short: scanning the whole row without branches is faster than a
+  // search with unpredictable branches.
+  int position = -1;
+  for (int i = 0; i < row_size_; ++i) {
+    position = (row[i].value == var_value.value) ? i : position;
+  }
+  return position >= 0 ? row + position : nullptr;
+}
+
+void GuidedLocalSearchPenaltiesRows::IncrementPenalty(
+    const VarValue& var_value) {
+  const Entry* const entry = FindEntry(var_value);
+  if (entry != nullptr) {
+    ++entries_[entry - entries_.data()].penalty;
+    penalized_in_row_[var_value.var] = true;
+  } else {
+    ++other_penalties_[var_value];
+    penalized_outside_row_[var_value.var] = true;
+  }
+  has_values_ = true;
+}
+
+void GuidedLocalSearchPenaltiesRows::Reset() {
+  has_values_ = false;
+  for (Entry& entry : entries_) entry.penalty = 0;
+  std::fill(penalized_in_row_.begin(), penalized_in_row_.end(), false);
+  std::fill(penalized_outside_row_.begin(), penalized_outside_row_.end(),
+            false);
+  other_penalties_.clear();
+}
+
+int64_t GuidedLocalSearchPenaltiesRows::GetPenalty(
+    const VarValue& var_value) const {
+  if (penalized_in_row_[var_value.var]) {
+    const Entry* const entry = FindEntry(var_value);
+    if (entry != nullptr) return entry->penalty;
+  }
+  return penalized_outside_row_[var_value.var]
+             ? gtl::FindWithDefault(other_penalties_, var_value)
+             : 0;
+}
+
 template <typename P>
 class GuidedLocalSearch : public Metaheuristic {
  public:
+  // The penalties are built from the number of variables followed by
+  // penalties_args.
+  template <typename... PenaltiesArgs>
   GuidedLocalSearch(Solver* const s, IntVar* objective, bool maximize,
                     int64_t step, const std::vector<IntVar*>& vars,
                     double penalty_factor,
-                    bool reset_penalties_on_new_best_solution);
+                    bool reset_penalties_on_new_best_solution,
+                    const PenaltiesArgs&... penalties_args);
   ~GuidedLocalSearch() override {}
   bool AcceptDelta(Assignment* delta, Assignment* deltadelta) override;
   void ApplyDecision(Decision* d) override;
@@ -3687,17 +3801,19 @@ class GuidedLocalSearch : public Metaheuristic {
 };
 
 template <typename P>
+template <typename... PenaltiesArgs>
 GuidedLocalSearch<P>::GuidedLocalSearch(
     Solver* const s, IntVar* objective, bool maximize, int64_t step,
     const std::vector<IntVar*>& vars, double penalty_factor,
-    bool reset_penalties_on_new_best_solution)
+    bool reset_penalties_on_new_best_solution,
+    const PenaltiesArgs&... penalties_args)
     : Metaheuristic(s, maximize, objective, step),
       penalized_objective_(nullptr),
       assignment_penalized_value_(0),
       old_penalized_value_(0),
       num_vars_(vars.size()),
       penalty_factor_(penalty_factor),
-      penalties_(vars.size()),
+      penalties_(vars.size(), penalties_args...),
       penalized_values_(vars.size()),
       incremental_(false),
       reset_penalties_on_new_best_solution_(
@@ -3906,11 +4022,13 @@ bool GuidedLocalSearch<P>::LocalOptimum() {
 template <typename P>
 class BinaryGuidedLocalSearch : public GuidedLocalSearch<P> {
  public:
+  template <typename... PenaltiesArgs>
   BinaryGuidedLocalSearch(
       Solver* const solver, IntVar* const objective,
       std::function<int64_t(int64_t, int64_t)> objective_function,
       bool maximize, int64_t step, const std::vector<IntVar*>& vars,
-      double penalty_factor, bool reset_penalties_on_new_best_solution);
+      double penalty_factor, bool reset_penalties_on_new_best_solution,
+      const PenaltiesArgs&... penalties_args);
   ~BinaryGuidedLocalSearch() override {}
   IntExpr* MakeElementPenalty(int index) override;
   int64_t AssignmentElementPenalty(int index) const override;
@@ -3924,14 +4042,16 @@ class BinaryGuidedLocalSearch : public GuidedLocalSearch<P> {
 };
 
 template <typename P>
+template <typename... PenaltiesArgs>
 BinaryGuidedLocalSearch<P>::BinaryGuidedLocalSearch(
     Solver* const solver, IntVar* const objective,
     std::function<int64_t(int64_t, int64_t)> objective_function, bool maximize,
     int64_t step, const std::vector<IntVar*>& vars, double penalty_factor,
-    bool reset_penalties_on_new_best_solution)
+    bool reset_penalties_on_new_best_solution,
+    const PenaltiesArgs&... penalties_args)
     : GuidedLocalSearch<P>(solver, objective, maximize, step, vars,
-                           penalty_factor,
-                           reset_penalties_on_new_best_solution),
+                           penalty_factor, reset_penalties_on_new_best_solution,
+                           penalties_args...),
       objective_function_(std::move(objective_function)) {}
 
 template <typename P>
@@ -3991,12 +4111,14 @@ int64_t BinaryGuidedLocalSearch<P>::PenalizedValue(int64_t i, int64_t j) const {
 template <typename P>
 class TernaryGuidedLocalSearch : public GuidedLocalSearch<P> {
  public:
+  template <typename... PenaltiesArgs>
   TernaryGuidedLocalSearch(
       Solver* const solver, IntVar* const objective,
       std::function<int64_t(int64_t, int64_t, int64_t)> objective_function,
       bool maximize, int64_t step, const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars, double penalty_factor,
-      bool reset_penalties_on_new_best_solution);
+      bool reset_penalties_on_new_best_solution,
+      const PenaltiesArgs&... penalties_args);
   ~TernaryGuidedLocalSearch() override {}
   IntExpr* MakeElementPenalty(int index) override;
   int64_t AssignmentElementPenalty(int index) const override;
@@ -4012,15 +4134,17 @@ class TernaryGuidedLocalSearch : public GuidedLocalSearch<P> {
 };
 
 template <typename P>
+template <typename... PenaltiesArgs>
 TernaryGuidedLocalSearch<P>::TernaryGuidedLocalSearch(
     Solver* const solver, IntVar* const objective,
     std::function<int64_t(int64_t, int64_t, int64_t)> objective_function,
     bool maximize, int64_t step, const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars, double penalty_factor,
-    bool reset_penalties_on_new_best_solution)
+    bool reset_penalties_on_new_best_solution,
+    const PenaltiesArgs&... penalties_args)
     : GuidedLocalSearch<P>(solver, objective, maximize, step, vars,
-                           penalty_factor,
-                           reset_penalties_on_new_best_solution),
+                           penalty_factor, reset_penalties_on_new_best_solution,
+                           penalties_args...),
       objective_function_(std::move(objective_function)),
       secondary_values_(this->NumPrimaryVars(), -1) {
   this->AddVars(secondary_vars);
@@ -4146,6 +4270,30 @@ SearchMonitor* Solver::MakeGuidedLocalSearch(
   }
 }
 
+SearchMonitor* Solver::MakeGuidedLocalSearchWithCandidates(
+    bool maximize, IntVar* const objective,
+    Solver::IndexEvaluator2 objective_function, int64_t step,
+    const std::vector<IntVar*>& vars,
+    const std::vector<std::vector<int64_t>>& candidate_values,
+    double penalty_factor, bool reset_penalties_on_new_best_solution) {
+  return RevAlloc(new BinaryGuidedLocalSearch<GuidedLocalSearchPenaltiesRows>(
+      this, objective, std::move(objective_function), maximize, step, vars,
+      penalty_factor, reset_penalties_on_new_best_solution, candidate_values));
+}
+
+SearchMonitor* Solver::MakeGuidedLocalSearchWithCandidates(
+    bool maximize, IntVar* const objective,
+    Solver::IndexEvaluator3 objective_function, int64_t step,
+    const std::vector<IntVar*>& vars,
+    const std::vector<IntVar*>& secondary_vars,
+    const std::vector<std::vector<int64_t>>& candidate_values,
+    double penalty_factor, bool reset_penalties_on_new_best_solution) {
+  return RevAlloc(new TernaryGuidedLocalSearch<GuidedLocalSearchPenaltiesRows>(
+      this, objective, std::move(objective_function), maximize, step, vars,
+      secondary_vars, penalty_factor, reset_penalties_on_new_best_solution,
+      candidate_values));
+}
+
 // ---------- Search Limits ----------
 
 // ----- Base Class -----
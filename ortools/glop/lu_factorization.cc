@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "ortools/lp_data/lp_types.h"
@@ -57,6 +58,12 @@ Status LuFactorization::ComputeFactorization(
   inverse_row_perm_.PopulateFromInverse(row_perm_);
   ComputeTransposeUpper();
   ComputeTransposeLower();
+#ifdef OMP
+  if (parameters_.use_level_scheduled_triangular_solves() &&
+      parameters_.num_omp_threads() > 1) {
+    ComputeLevelSchedules();
+  }
+#endif
 
   is_identity_factorization_ = false;
   IF_STATS_ENABLED({
@@ -103,8 +110,8 @@ void LuFactorization::RightSolve(DenseColumn* x) const {
   if (is_identity_factorization_) return;
 
   ApplyPermutation(row_perm_, *x, &dense_column_scratchpad_);
-  lower_.LowerSolve(&dense_column_scratchpad_);
-  upper_.UpperSolve(&dense_column_scratchpad_);
+  DenseLowerSolve(ColIndex(0), &dense_column_scratchpad_);
+  DenseUpperSolve(&dense_column_scratchpad_);
   ApplyPermutation(inverse_col_perm_, dense_column_scratchpad_, x);
 }
 
@@ -115,8 +122,8 @@ void LuFactorization::LeftSolve(DenseRow* y) const {
   // We need to interpret y as a column for the permutation functions.
   DenseColumn* const x = reinterpret_cast<DenseColumn*>(y);
   ApplyInversePermutation(inverse_col_perm_, *x, &dense_column_scratchpad_);
-  upper_.TransposeUpperSolve(&dense_column_scratchpad_);
-  lower_.TransposeLowerSolve(&dense_column_scratchpad_);
+  DenseTransposeUpperSolve(&dense_column_scratchpad_);
+  DenseTransposeLowerSolve(&dense_column_scratchpad_);
   ApplyInversePermutation(row_perm_, dense_column_scratchpad_, x);
 }
 
@@ -154,15 +161,13 @@ Fractional LuFactorization::RightSolveSquaredNorm(const ColumnView& a) const {
     non_zero_rows_.push_back(permuted_row);
   }
 
-  lower_.ComputeRowsToConsiderInSortedOrder(&non_zero_rows_);
-  if (non_zero_rows_.empty()) {
-    lower_.LowerSolve(&dense_zero_scratchpad_);
-  } else {
-    lower_.HyperSparseSolve(&dense_zero_scratchpad_, &non_zero_rows_);
+  LowerSolveWithNonZeros(ColIndex(0), &dense_zero_scratchpad_,
+                         &non_zero_rows_);
+  if (!non_zero_rows_.empty()) {
     upper_.ComputeRowsToConsiderInSortedOrder(&non_zero_rows_);
   }
   if (non_zero_rows_.empty()) {
-    upper_.UpperSolve(&dense_zero_scratchpad_);
+    DenseUpperSolve(&dense_zero_scratchpad_);
   } else {
     upper_.HyperSparseSolveWithReversedNonZeros(&dense_zero_scratchpad_,
                                                 &non_zero_rows_);
@@ -219,12 +224,8 @@ void LuFactorization::RightSolveLWithPermutedInput(const DenseColumn& a,
   SCOPED_TIME_STAT(&stats_);
   if (!is_identity_factorization_) {
     DCHECK(AreEqualWithPermutation(a, x->values, row_perm_));
-    lower_.ComputeRowsToConsiderInSortedOrder(&x->non_zeros);
-    if (x->non_zeros.empty()) {
-      lower_.LowerSolve(&x->values);
-    } else {
-      lower_.HyperSparseSolve(&x->values, &x->non_zeros);
-    }
+    x->non_zeros_are_sorted =
+        LowerSolveWithNonZeros(ColIndex(0), &x->values, &x->non_zeros);
   }
 }
 
@@ -253,13 +254,8 @@ void LuFactorization::RightSolveLInternal(const Column& b,
     first_column_to_consider = std::min(first_column_to_consider, col);
   }
 
-  lower_.ComputeRowsToConsiderInSortedOrder(&x->non_zeros);
-  x->non_zeros_are_sorted = true;
-  if (x->non_zeros.empty()) {
-    lower_.LowerSolveStartingAt(first_column_to_consider, &x->values);
-  } else {
-    lower_.HyperSparseSolve(&x->values, &x->non_zeros);
-  }
+  x->non_zeros_are_sorted = LowerSolveWithNonZeros(
+      first_column_to_consider, &x->values, &x->non_zeros);
 }
 
 void LuFactorization::RightSolveLForColumnView(const ColumnView& b,
@@ -282,19 +278,14 @@ void LuFactorization::RightSolveLWithNonZeros(ScatteredColumn* x) const {
   if (is_identity_factorization_) return;
   if (x->non_zeros.empty()) {
     PermuteWithScratchpad(row_perm_, &dense_zero_scratchpad_, &x->values);
-    lower_.LowerSolve(&x->values);
+    DenseLowerSolve(ColIndex(0), &x->values);
     return;
   }
 
   PermuteWithKnownNonZeros(row_perm_, &dense_zero_scratchpad_, &x->values,
                            &x->non_zeros);
-  lower_.ComputeRowsToConsiderInSortedOrder(&x->non_zeros);
-  x->non_zeros_are_sorted = true;
-  if (x->non_zeros.empty()) {
-    lower_.LowerSolve(&x->values);
-  } else {
-    lower_.HyperSparseSolve(&x->values, &x->non_zeros);
-  }
+  x->non_zeros_are_sorted =
+      LowerSolveWithNonZeros(ColIndex(0), &x->values, &x->non_zeros);
 }
 
 void LuFactorization::RightSolveLForScatteredColumn(const ScatteredColumn& b,
@@ -326,7 +317,7 @@ void LuFactorization::LeftSolveUWithNonZeros(ScatteredRow* y) const {
   transpose_upper_.ComputeRowsToConsiderInSortedOrder(nz);
   y->non_zeros_are_sorted = true;
   if (nz->empty()) {
-    upper_.TransposeUpperSolve(x);
+    DenseTransposeUpperSolve(x);
   } else {
     upper_.TransposeHyperSparseSolve(x, nz);
   }
@@ -364,7 +355,7 @@ bool LuFactorization::LeftSolveLWithNonZeros(
   transpose_lower_.ComputeRowsToConsiderInSortedOrder(nz);
   y->non_zeros_are_sorted = true;
   if (nz->empty()) {
-    lower_.TransposeLowerSolve(x);
+    DenseTransposeLowerSolve(x);
   } else {
     lower_.TransposeHyperSparseSolveWithReversedNonZeros(x, nz);
   }
@@ -565,6 +556,81 @@ double ComputeDensity(const SparseColumn& b, const RowPermutation& row_perm) {
 }
 }  // anonymous namespace
 
+bool LuFactorization::LowerSolveWithNonZeros(ColIndex start, DenseColumn* x,
+                                             RowIndexVector* non_zeros) const {
+  if (parameters_.use_dfs_in_hypersparse_solves()) {
+    // The depth-first search returns the non-zeros in the reverse order of the
+    // one in which they need to be processed.
+    lower_.ComputeRowsToConsiderWithDfs(non_zeros);
+    if (non_zeros->empty()) {
+      DenseLowerSolve(start, x);
+      return true;
+    }
+    lower_.HyperSparseSolveWithReversedNonZeros(x, non_zeros);
+    return false;
+  }
+  lower_.ComputeRowsToConsiderInSortedOrder(non_zeros);
+  if (non_zeros->empty()) {
+    DenseLowerSolve(start, x);
+  } else {
+    lower_.HyperSparseSolve(x, non_zeros);
+  }
+  return true;
+}
+
+// Note that L.x = b is the same as Transpose(Transpose(L)).x = b, so the
+// level-scheduled solves of L and U use the transposed factors and vice versa.
+void LuFactorization::DenseLowerSolve(ColIndex start, DenseColumn* x) const {
+  if (transpose_lower_.HasLevelSchedule()) {
+    transpose_lower_.TransposeSolveWithLevels(x, parameters_.num_omp_threads());
+  } else {
+    lower_.LowerSolveStartingAt(start, x);
+  }
+}
+
+void LuFactorization::DenseUpperSolve(DenseColumn* x) const {
+  if (transpose_upper_.HasLevelSchedule()) {
+    transpose_upper_.TransposeSolveWithLevels(x, parameters_.num_omp_threads());
+  } else {
+    upper_.UpperSolve(x);
+  }
+}
+
+void LuFactorization::DenseTransposeLowerSolve(DenseColumn* x) const {
+  if (lower_.HasLevelSchedule()) {
+    lower_.TransposeSolveWithLevels(x, parameters_.num_omp_threads());
+  } else {
+    lower_.TransposeLowerSolve(x);
+  }
+}
+
+void LuFactorization::DenseTransposeUpperSolve(DenseColumn* x) const {
+  if (upper_.HasLevelSchedule()) {
+    upper_.TransposeSolveWithLevels(x, parameters_.num_omp_threads());
+  } else {
+    upper_.TransposeUpperSolve(x);
+  }
+}
+
+void LuFactorization::ComputeLevelSchedules() {
+  SCOPED_TIME_STAT(&stats_);
+  // The level-scheduled solves access the columns in a less cache-friendly
+  // order than the plain ones: on a single thread, they were measured to be
+  // about three times slower (see examples/cpp/lu_solve_benchmark.cc). We thus
+  // only keep a schedule when its average level is wide enough to be split
+  // between all the threads.
+  const int kMinColumnsPerThread = 64;
+  const int num_threads = parameters_.num_omp_threads();
+  for (TriangularMatrix* matrix :
+       {&lower_, &upper_, &transpose_lower_, &transpose_upper_}) {
+    matrix->ComputeLevelSchedule();
+    if (matrix->num_cols().value() <
+        int64_t{kMinColumnsPerThread} * num_threads * matrix->NumLevels()) {
+      matrix->ClearLevelSchedule();
+    }
+  }
+}
+
 void LuFactorization::ComputeTransposeUpper() {
   SCOPED_TIME_STAT(&stats_);
   transpose_upper_.PopulateFromTranspose(upper_);
@@ -243,6 +243,28 @@ class LuFactorization {
   template <typename Column>
   void RightSolveLInternal(const Column& b, ScatteredColumn* x) const;
 
+  // Performs a solve by lower_ of x that is zero before the column start. If
+  // non_zeros is not empty, it must contain the non-zero positions of x and an
+  // hyper-sparse solve is used if the result is sparse enough, in which case
+  // non_zeros is updated to the non-zeros of the result. Otherwise, it is
+  // cleared. Returns true iff non_zeros is sorted.
+  bool LowerSolveWithNonZeros(ColIndex start, DenseColumn* x,
+                              RowIndexVector* non_zeros) const;
+
+  // Dense triangular solves with the factors. When the level schedules were
+  // computed (see ComputeLevelSchedules()), these use the parallel
+  // level-scheduled solves of the row-wise stored factor.
+  void DenseLowerSolve(ColIndex start, DenseColumn* x) const;
+  void DenseUpperSolve(DenseColumn* x) const;
+  void DenseTransposeLowerSolve(DenseColumn* x) const;
+  void DenseTransposeUpperSolve(DenseColumn* x) const;
+
+  // Computes the level schedules of the four triangular matrices. This is only
+  // done with use_level_scheduled_triangular_solves and more than one OMP
+  // thread, and a schedule is dropped when its levels are too narrow to be
+  // worth splitting between the threads.
+  void ComputeLevelSchedules();
+
   // Fills transpose_upper_ from upper_.
   void ComputeTransposeUpper();
 
@@ -21,6 +21,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "ortools/graph/graph.h"
 #include "ortools/graph/graphs.h"
 
@@ -599,62 +600,66 @@ void GenericMaxFlow<Graph>::GlobalUpdate() {
   // Note that the second pass is not needed here if we use a two-pass algorithm
   // to return the flow to the source after we found the min cut.
   const int num_passes = use_two_phase_algorithm_ ? 1 : 2;
-  for (int pass = 0; pass < num_passes; ++pass) {
-    if (pass == 0) {
-      bfs_queue_.push_back(sink_);
-    } else {
-      bfs_queue_.push_back(source_);
-    }
-
-    while (queue_index != bfs_queue_.size()) {
-      const NodeIndex node = bfs_queue_[queue_index];
-      ++queue_index;
-      const NodeIndex candidate_distance = node_potential_[node] + 1;
-      for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node); it.Ok();
-           it.Next()) {
-        const ArcIndex arc = it.Index();
-        const NodeIndex head = Head(arc);
+  if (num_threads_for_global_update_ > 1) {
+    ParallelGlobalUpdateBfs(num_passes);
+  } else {
+    for (int pass = 0; pass < num_passes; ++pass) {
+      if (pass == 0) {
+        bfs_queue_.push_back(sink_);
+      } else {
+        bfs_queue_.push_back(source_);
+      }
 
-        // Skip the arc if the height of head was already set to the correct
-        // value (Remember we are doing reverse BFS).
-        if (node_in_bfs_queue_[head]) continue;
-
-        // TODO(user): By using more memory we can speed this up quite a bit by
-        // avoiding to take the opposite arc here, too options:
-        // - if (residual_arc_capacity_[arc] != arc_capacity_[arc])
-        // - if (opposite_arc_is_admissible_[arc])  // need updates.
-        // Experiment with the first option shows more than 10% gain on this
-        // function running time, which is the bottleneck on many instances.
-        const ArcIndex opposite_arc = Opposite(arc);
-        if (residual_arc_capacity_[opposite_arc] > 0) {
-          // Note(user): We used to have a DCHECK_GE(candidate_distance,
-          // node_potential_[head]); which is always true except in the case
-          // where we can push more than kMaxFlowQuantity out of the source. The
-          // problem comes from the fact that in this case, we call
-          // PushFlowExcessBackToSource() in the middle of the algorithm. The
-          // later call will break the properties of the node potential. Note
-          // however, that this function will recompute a good node potential
-          // for all the nodes and thus fix the issue.
-
-          // If head is active, we can steal some or all of its excess.
-          // This brings a huge gain on some problems.
-          // Note(user): I haven't seen this anywhere in the literature.
-          // TODO(user): Investigate more and maybe write a publication :)
-          if (node_excess_[head] > 0) {
-            const FlowQuantity flow = std::min(
-                node_excess_[head], residual_arc_capacity_[opposite_arc]);
-            PushFlow(flow, opposite_arc);
+      while (queue_index != bfs_queue_.size()) {
+        const NodeIndex node = bfs_queue_[queue_index];
+        ++queue_index;
+        const NodeIndex candidate_distance = node_potential_[node] + 1;
+        for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node); it.Ok();
+             it.Next()) {
+          const ArcIndex arc = it.Index();
+          const NodeIndex head = Head(arc);
+
+          // Skip the arc if the height of head was already set to the correct
+          // value (Remember we are doing reverse BFS).
+          if (node_in_bfs_queue_[head]) continue;
+
+          // TODO(user): By using more memory we can speed this up quite a bit
+          // by avoiding to take the opposite arc here, too options:
+          // - if (residual_arc_capacity_[arc] != arc_capacity_[arc])
+          // - if (opposite_arc_is_admissible_[arc])  // need updates.
+          // Experiment with the first option shows more than 10% gain on this
+          // function running time, which is the bottleneck on many instances.
+          const ArcIndex opposite_arc = Opposite(arc);
+          if (residual_arc_capacity_[opposite_arc] > 0) {
+            // Note(user): We used to have a DCHECK_GE(candidate_distance,
+            // node_potential_[head]); which is always true except in the case
+            // where we can push more than kMaxFlowQuantity out of the source.
+            // The problem comes from the fact that in this case, we call
+            // PushFlowExcessBackToSource() in the middle of the algorithm. The
+            // later call will break the properties of the node potential. Note
+            // however, that this function will recompute a good node potential
+            // for all the nodes and thus fix the issue.
+
+            // If head is active, we can steal some or all of its excess.
+            // This brings a huge gain on some problems.
+            // Note(user): I haven't seen this anywhere in the literature.
+            // TODO(user): Investigate more and maybe write a publication :)
+            if (node_excess_[head] > 0) {
+              const FlowQuantity flow = std::min(
+                  node_excess_[head], residual_arc_capacity_[opposite_arc]);
+              PushFlow(flow, opposite_arc);
+
+              // If the arc became saturated, it is no longer in the residual
+              // graph, so we do not need to consider head at this time.
+              if (residual_arc_capacity_[opposite_arc] == 0) continue;
+            }
 
-            // If the arc became saturated, it is no longer in the residual
-            // graph, so we do not need to consider head at this time.
-            if (residual_arc_capacity_[opposite_arc] == 0) continue;
+            // Note that there is no need to touch first_admissible_arc_[node]
+            // because of the relaxed Relabel() we use.
+            node_potential_[head] = candidate_distance;
+            node_in_bfs_queue_[head] = true;
+            bfs_queue_.push_back(head);
           }
-
-          // Note that there is no need to touch first_admissible_arc_[node]
-          // because of the relaxed Relabel() we use.
-          node_potential_[head] = candidate_distance;
-          node_in_bfs_queue_[head] = true;
-          bfs_queue_.push_back(head);
         }
       }
     }
@@ -689,6 +694,90 @@ void GenericMaxFlow<Graph>::GlobalUpdate() {
   }
 }
 
+template <typename Graph>
+void GenericMaxFlow<Graph>::ParallelGlobalUpdateBfs(int num_passes) {
+  SCOPED_TIME_STAT(&stats_);
+  // Levels with fewer nodes per thread are not worth the synchronization.
+  const int kMinNodesPerThread = 1024;
+  const int num_threads = num_threads_for_global_update_;
+  if (global_update_pool_ == nullptr) {
+    global_update_pool_ =
+        std::make_unique<ThreadPool>("MaxFlowGlobalUpdate", num_threads - 1);
+    global_update_pool_->StartWorkers();
+  }
+  bfs_level_arcs_.resize(num_threads);
+
+  // Collects, in the order in which GlobalUpdate() would look at them, the
+  // arcs from the given nodes of the current level to the nodes not yet in the
+  // queue that are in the residual graph. This only reads the shared data, so
+  // the blocks of a level can be scanned concurrently.
+  const auto collect_arcs = [this](int begin, int end,
+                                   std::vector<ArcIndex>* arcs) {
+    for (int i = begin; i < end; ++i) {
+      for (OutgoingOrOppositeIncomingArcIterator it(*graph_, bfs_queue_[i]);
+           it.Ok(); it.Next()) {
+        const ArcIndex arc = it.Index();
+        if (node_in_bfs_queue_[Head(arc)]) continue;
+        if (residual_arc_capacity_[Opposite(arc)] <= 0) continue;
+        arcs->push_back(arc);
+      }
+    }
+  };
+
+  for (int pass = 0; pass < num_passes; ++pass) {
+    bfs_queue_.push_back(pass == 0 ? sink_ : source_);
+    int level_begin = bfs_queue_.size() - 1;
+    while (level_begin != bfs_queue_.size()) {
+      const int level_end = bfs_queue_.size();
+      const int level_size = level_end - level_begin;
+      const int num_tasks = std::max(
+          1, std::min(num_threads, level_size / kMinNodesPerThread));
+      if (num_tasks == 1) {
+        collect_arcs(level_begin, level_end, &bfs_level_arcs_[0]);
+      } else {
+        // The calling thread scans the first block of the level.
+        absl::BlockingCounter blocks_to_scan(num_tasks - 1);
+        const auto block_begin = [=](int task) {
+          return level_begin + static_cast<int64_t>(level_size) * task /
+                                   num_tasks;
+        };
+        for (int task = 1; task < num_tasks; ++task) {
+          global_update_pool_->Schedule([&, task]() {
+            collect_arcs(block_begin(task), block_begin(task + 1),
+                         &bfs_level_arcs_[task]);
+            blocks_to_scan.DecrementCount();
+          });
+        }
+        collect_arcs(block_begin(0), block_begin(1), &bfs_level_arcs_[0]);
+        blocks_to_scan.Wait();
+      }
+      level_begin = level_end;
+
+      // Applies the arcs in order, exactly like GlobalUpdate() does. A head
+      // whose excess saturates the arc is left out of the queue, so it can
+      // still be reached through one of the next arcs.
+      for (int task = 0; task < num_tasks; ++task) {
+        for (const ArcIndex arc : bfs_level_arcs_[task]) {
+          const NodeIndex head = Head(arc);
+          if (node_in_bfs_queue_[head]) continue;
+          const ArcIndex opposite_arc = Opposite(arc);
+          if (residual_arc_capacity_[opposite_arc] <= 0) continue;
+          if (node_excess_[head] > 0) {
+            const FlowQuantity flow = std::min(
+                node_excess_[head], residual_arc_capacity_[opposite_arc]);
+            PushFlow(flow, opposite_arc);
+            if (residual_arc_capacity_[opposite_arc] == 0) continue;
+          }
+          node_potential_[head] = node_potential_[Head(opposite_arc)] + 1;
+          node_in_bfs_queue_[head] = true;
+          bfs_queue_.push_back(head);
+        }
+        bfs_level_arcs_[task].clear();
+      }
+    }
+  }
+}
+
 template <typename Graph>
 bool GenericMaxFlow<Graph>::SaturateOutgoingArcsFromSource() {
   SCOPED_TIME_STAT(&stats_);
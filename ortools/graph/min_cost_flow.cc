@@ -67,7 +67,10 @@ GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::GenericMinCostFlow(
       stats_("MinCostFlow"),
       feasibility_checked_(false),
       use_price_update_(false),
-      check_feasibility_(absl::GetFlag(FLAGS_min_cost_flow_check_feasibility)) {
+      check_feasibility_(absl::GetFlag(FLAGS_min_cost_flow_check_feasibility)),
+      use_warm_start_(false),
+      can_warm_start_(false),
+      warm_start_cost_scaling_factor_(1) {
   const NodeIndex max_num_nodes = Graphs<Graph>::NodeReservation(*graph_);
   if (max_num_nodes > 0) {
     node_excess_.Reserve(0, max_num_nodes - 1);
@@ -94,7 +97,14 @@ template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetNodeSupply(
     NodeIndex node, FlowQuantity supply) {
   DCHECK(graph_->IsNodeValid(node));
-  node_excess_.Set(node, supply);
+  if (use_warm_start_) {
+    // Keep the current flow: node_excess_ is the supply minus the net flow
+    // leaving the node.
+    node_excess_.Set(node,
+                     node_excess_[node] + supply - initial_node_excess_[node]);
+  } else {
+    node_excess_.Set(node, supply);
+  }
   initial_node_excess_.Set(node, supply);
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
@@ -159,6 +169,7 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetArcFlow(
   residual_arc_capacity_.Set(arc, capacity - new_flow);
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
+  can_warm_start_ = false;
 }
 
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
@@ -407,6 +418,7 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::MakeFeasible() {
     node_excess_.Set(node, excess);
     initial_node_excess_.Set(node, excess);
   }
+  can_warm_start_ = false;
   return true;
 }
 
@@ -512,6 +524,8 @@ GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
   status_ = NOT_SOLVED;
+  const bool warm_start = use_warm_start_ && can_warm_start_;
+  can_warm_start_ = false;
   if (absl::GetFlag(FLAGS_min_cost_flow_check_balance) &&
       !CheckInputConsistency()) {
     status_ = UNBALANCED;
@@ -525,21 +539,29 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
     status_ = INFEASIBLE;
     return false;
   }
-  node_potential_.SetAll(0);
   ResetFirstAdmissibleArcs();
   ScaleCosts();
+  if (warm_start && cost_scaling_factor_ == warm_start_cost_scaling_factor_) {
+    epsilon_ = ComputeWarmStartEpsilon();
+    VLOG(3) << "Warm start epsilon = " << epsilon_;
+  } else {
+    node_potential_.SetAll(0);
+  }
   Optimize();
   if (absl::GetFlag(FLAGS_min_cost_flow_check_result) && !CheckResult()) {
     status_ = BAD_RESULT;
     UnscaleCosts();
     return false;
   }
+  const CostValue cost_scaling_factor = cost_scaling_factor_;
   UnscaleCosts();
   if (status_ != OPTIMAL) {
     LOG(DFATAL) << "Status != OPTIMAL";
     return false;
   }
   status_ = OPTIMAL;
+  can_warm_start_ = true;
+  warm_start_cost_scaling_factor_ = cost_scaling_factor;
   IF_STATS_ENABLED(VLOG(1) << stats_.StatString());
   return true;
 }
@@ -595,6 +617,35 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::ScaleCosts() {
   VLOG(3) << "Cost scaling factor = " << cost_scaling_factor_;
 }
 
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+CostValue GenericMinCostFlow<Graph, ArcFlowType,
+                             ArcScaledCostType>::ComputeWarmStartEpsilon() {
+  SCOPED_TIME_STAT(&stats_);
+  // Relabel() only decreases the potentials, shift them back so that they do
+  // not drift towards an overflow over a long sequence of warm-started solves.
+  // This does not change any reduced cost.
+  CostValue max_potential = std::numeric_limits<CostValue>::min();
+  for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
+    max_potential = std::max(max_potential, node_potential_[node]);
+  }
+  if (max_potential != 0) {
+    for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
+      node_potential_.Set(node, node_potential_[node] - max_potential);
+    }
+  }
+  CostValue epsilon = 1LL;
+  for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
+    if (residual_arc_capacity_[arc] > 0) {
+      epsilon = std::max(epsilon, -ReducedCost(arc));
+    }
+    const ArcIndex opposite = Opposite(arc);
+    if (residual_arc_capacity_[opposite] > 0) {
+      epsilon = std::max(epsilon, -ReducedCost(opposite));
+    }
+  }
+  return epsilon;
+}
+
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::UnscaleCosts() {
   SCOPED_TIME_STAT(&stats_);
@@ -347,7 +347,8 @@ class GenericMinCostFlow : public MinCostFlowBase {
   Status status() const { return status_; }
 
   // Sets the supply corresponding to node. A demand is modeled as a negative
-  // supply.
+  // supply. With warm start enabled, the flow already leaving the node is kept
+  // and only the difference with the previous supply becomes an excess.
   void SetNodeSupply(NodeIndex node, FlowQuantity supply);
 
   // Sets the unit cost for the given arc.
@@ -422,6 +423,15 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // forever.
   void SetCheckFeasibility(bool value) { check_feasibility_ = value; }
 
+  // Whether Solve() should start from the flow and node potentials found by
+  // the last successful Solve() instead of from zero potentials. This is
+  // useful when solving a sequence of problems differing by a few calls to
+  // SetNodeSupply(), SetArcUnitCost() or SetArcCapacity(): the cost scaling
+  // then starts from the largest violation of the reduced cost optimality
+  // conditions by the previous solution instead of from the largest cost.
+  // Calling SetArcFlow() or MakeFeasible() discards the warm start.
+  void SetUseWarmStart(bool value) { use_warm_start_ = value; }
+
  private:
   // Returns true if the given arc is admissible i.e. if its residual capacity
   // is strictly positive, and its reduced cost strictly negative, i.e., pushing
@@ -470,6 +480,12 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Scales the costs, by multiplying them by (graph_->num_nodes() + 1).
   void ScaleCosts();
 
+  // Returns the smallest epsilon for which the current pseudo-flow and node
+  // potentials are epsilon-optimal, i.e. the largest negative reduced cost of
+  // an arc with a positive residual capacity. Costs must be scaled. The
+  // potentials are first shifted so that the largest one is zero.
+  CostValue ComputeWarmStartEpsilon();
+
   // Unscales the costs, by dividing them by (graph_->num_nodes() + 1).
   void UnscaleCosts();
 
@@ -605,6 +621,15 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Whether to check the problem feasibility with a max-flow.
   bool check_feasibility_;
 
+  // Whether to warm-start Solve() from the previous flow and potentials.
+  bool use_warm_start_;
+
+  // True when the flow and potentials are those of a successful Solve() that
+  // used cost_scaling_factor_ = warm_start_cost_scaling_factor_. The potentials
+  // are only meaningful for this scaling factor.
+  bool can_warm_start_;
+  CostValue warm_start_cost_scaling_factor_;
+
   DISALLOW_COPY_AND_ASSIGN(GenericMinCostFlow);
 };
 
@@ -0,0 +1,375 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/linear_solver/concurrent_lp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/linear_solver/linear_solver.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/linear_solver/proto_solver/pdlp_proto_solver.h"
+#include "ortools/pdlp/solve_log.pb.h"
+
+namespace operations_research {
+
+namespace {
+
+enum Racer { kGlopPrimal = 0, kGlopDual = 1, kPdlp = 2, kNumRacers = 3 };
+
+constexpr absl::string_view kRacerNames[kNumRacers] = {
+    "Glop primal simplex", "Glop dual simplex", "PDLP"};
+
+// A status that makes the other racers useless.
+bool IsConclusive(MPSolverResponseStatus status) {
+  return status == MPSOLVER_OPTIMAL || status == MPSOLVER_INFEASIBLE ||
+         status == MPSOLVER_UNBOUNDED;
+}
+
+bool HasSolution(MPSolverResponseStatus status) {
+  return status == MPSOLVER_OPTIMAL || status == MPSOLVER_FEASIBLE;
+}
+
+MPModelRequest RacerRequest(const MPModelRequest& request, Racer racer) {
+  MPModelRequest racer_request = request;
+  racer_request.clear_solver_specific_parameters();
+  if (racer == kPdlp) {
+    racer_request.set_solver_type(MPModelRequest::PDLP_LINEAR_PROGRAMMING);
+    return racer_request;
+  }
+  racer_request.set_solver_type(MPModelRequest::GLOP_LINEAR_PROGRAMMING);
+  racer_request.set_solver_specific_parameters(
+      racer == kGlopDual ? "use_dual_simplex: true"
+                         : "use_dual_simplex: false");
+  for (MPVariableProto& variable :
+       *racer_request.mutable_model()->mutable_variable()) {
+    variable.clear_is_integer();
+  }
+  return racer_request;
+}
+
+struct RaceState {
+  bool Done() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    return winner >= 0 || num_finished == kNumRacers;
+  }
+  bool AllFinished() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    return num_finished == kNumRacers;
+  }
+
+  absl::Mutex mutex;
+  int num_finished ABSL_GUARDED_BY(mutex) = 0;
+  int winner ABSL_GUARDED_BY(mutex) = -1;
+};
+
+// The result of one racer.
+struct RacerResult {
+  absl::StatusOr<MPSolutionResponse> response;
+  ConcurrentLpSolveInfo info;
+};
+
+// Guesses the status of a variable or constraint from its value in an interior
+// point solution: only the ones at one of their bounds are non-basic.
+MPSolver::BasisStatus GuessBasisStatus(double lower_bound, double upper_bound,
+                                       double value) {
+  constexpr double kBoundTolerance = 1e-6;
+  const auto is_at = [value](double bound) {
+    return std::isfinite(bound) &&
+           std::abs(value - bound) <=
+               kBoundTolerance * std::max(1.0, std::abs(bound));
+  };
+  if (lower_bound == upper_bound) return MPSolver::FIXED_VALUE;
+  if (is_at(lower_bound)) return MPSolver::AT_LOWER_BOUND;
+  if (is_at(upper_bound)) return MPSolver::AT_UPPER_BOUND;
+  if (!std::isfinite(lower_bound) && !std::isfinite(upper_bound) &&
+      std::abs(value) <= kBoundTolerance) {
+    return MPSolver::FREE;
+  }
+  return MPSolver::BASIC;
+}
+
+// Guesses a basis from the given variable values, see GuessBasisStatus().
+void GuessBasis(const MPModelProto& model,
+                absl::Span<const double> variable_values,
+                ConcurrentLpSolveInfo* info) {
+  info->variable_statuses.clear();
+  info->variable_statuses.reserve(model.variable_size());
+  for (int v = 0; v < model.variable_size(); ++v) {
+    const MPVariableProto& variable = model.variable(v);
+    info->variable_statuses.push_back(GuessBasisStatus(
+        variable.lower_bound(), variable.upper_bound(), variable_values[v]));
+  }
+  info->constraint_statuses.clear();
+  info->constraint_statuses.reserve(model.constraint_size());
+  for (const MPConstraintProto& constraint : model.constraint()) {
+    double activity = 0.0;
+    for (int i = 0; i < constraint.var_index_size(); ++i) {
+      activity +=
+          constraint.coefficient(i) * variable_values[constraint.var_index(i)];
+    }
+    info->constraint_statuses.push_back(GuessBasisStatus(
+        constraint.lower_bound(), constraint.upper_bound(), activity));
+  }
+}
+
+// Fills the iteration count and, if there is a solution, the basis of a solve
+// done with the given MPSolver.
+void FillSolveInfo(const MPSolver& solver, MPSolverResponseStatus status,
+                   ConcurrentLpSolveInfo* info) {
+  info->iterations = solver.iterations();
+  info->variable_statuses.clear();
+  info->constraint_statuses.clear();
+  if (!HasSolution(status)) return;
+  for (const MPVariable* variable : solver.variables()) {
+    info->variable_statuses.push_back(variable->basis_status());
+  }
+  for (const MPConstraint* constraint : solver.constraints()) {
+    info->constraint_statuses.push_back(constraint->basis_status());
+  }
+}
+
+// Solves a Glop racer request with the given solver, which the caller can
+// interrupt with MPSolver::InterruptSolve(). Unlike MPSolver::SolveWithProto(),
+// this keeps the solver around to read its basis and iteration count.
+RacerResult SolveGlopRacer(const MPModelRequest& request,
+                           const std::string& glop_parameters,
+                           MPSolver* solver) {
+  RacerResult result;
+  MPSolutionResponse response;
+  std::string error_message;
+  response.set_status(
+      solver->LoadModelFromProto(request.model(), &error_message));
+  if (response.status() != MPSOLVER_MODEL_IS_VALID) {
+    response.set_status_str(error_message);
+    result.response = std::move(response);
+    return result;
+  }
+  if (request.enable_internal_solver_output()) solver->EnableOutput();
+  if (request.has_solver_time_limit_seconds()) {
+    solver->SetTimeLimit(absl::Seconds(request.solver_time_limit_seconds()));
+  }
+  if (!solver->SetSolverSpecificParametersAsString(absl::StrCat(
+          request.solver_specific_parameters(), " ", glop_parameters))) {
+    response.set_status(MPSOLVER_MODEL_INVALID_SOLVER_PARAMETERS);
+    result.response = std::move(response);
+    return result;
+  }
+  solver->Solve();
+  solver->FillSolutionResponseProto(&response);
+  FillSolveInfo(*solver, response.status(), &result.info);
+  result.response = std::move(response);
+  return result;
+}
+
+RacerResult SolvePdlpRacer(const MPModelRequest& request,
+                           std::atomic<bool>* interrupt) {
+  RacerResult result;
+  result.response = PdlpSolveProto(request, /*relax_integer_variables=*/true,
+                                   interrupt);
+  if (!result.response.ok()) return result;
+  pdlp::SolveLog solve_log;
+  if (solve_log.ParseFromString(result.response->solver_specific_info())) {
+    result.info.iterations = solve_log.iteration_count();
+  }
+  if (HasSolution(result.response->status()) &&
+      result.response->variable_value_size() ==
+          request.model().variable_size()) {
+    GuessBasis(request.model(), result.response->variable_value(),
+               &result.info);
+  }
+  return result;
+}
+
+// Runs a Glop primal simplex warm-started from the basis guessed from the
+// given PDLP solution. Returns false if it did not finish with an optimal
+// status, in which case the response and info are left untouched. Otherwise
+// the crossover iterations are added to the ones of info.
+bool CrossoverWithGlop(const MPModelRequest& glop_request,
+                       const MPSolutionResponse& pdlp_response,
+                       absl::Duration time_limit, MPSolutionResponse* response,
+                       ConcurrentLpSolveInfo* info) {
+  const MPModelProto& model = glop_request.model();
+  MPSolver solver(model.name(), MPSolver::GLOP_LINEAR_PROGRAMMING);
+  std::string error_message;
+  if (solver.LoadModelFromProto(model, &error_message) !=
+      MPSOLVER_MODEL_IS_VALID) {
+    LOG(WARNING) << "Crossover failed to load the model: " << error_message;
+    return false;
+  }
+  if (pdlp_response.variable_value_size() != model.variable_size()) {
+    return false;
+  }
+  ConcurrentLpSolveInfo guessed;
+  GuessBasis(model, pdlp_response.variable_value(), &guessed);
+
+  // Glop completes or repairs the guessed basis if it does not have the right
+  // number of basic columns or is singular.
+  solver.SetStartingLpBasis(guessed.variable_statuses,
+                            guessed.constraint_statuses);
+  if (time_limit < absl::InfiniteDuration()) {
+    solver.SetTimeLimit(time_limit);
+  }
+  if (glop_request.enable_internal_solver_output()) {
+    solver.EnableOutput();
+  }
+  MPSolverParameters parameters;
+  // The presolve would make the starting basis meaningless.
+  parameters.SetIntegerParam(MPSolverParameters::PRESOLVE,
+                             MPSolverParameters::PRESOLVE_OFF);
+  parameters.SetIntegerParam(MPSolverParameters::LP_ALGORITHM,
+                             MPSolverParameters::PRIMAL);
+  if (solver.Solve(parameters) != MPSolver::OPTIMAL) return false;
+  solver.FillSolutionResponseProto(response);
+  const int64_t pdlp_iterations = info->iterations;
+  FillSolveInfo(solver, response->status(), info);
+  if (pdlp_iterations > 0) info->iterations += pdlp_iterations;
+  return true;
+}
+
+}  // namespace
+
+absl::StatusOr<MPSolutionResponse> ConcurrentLpSolveProto(
+    const MPModelRequest& request, const bool crossover,
+    const std::atomic<bool>* interrupt_solve,
+    const std::string& glop_parameters, ConcurrentLpSolveInfo* solve_info) {
+  const absl::Time start_time = absl::Now();
+  if (solve_info != nullptr) *solve_info = ConcurrentLpSolveInfo();
+  if (interrupt_solve != nullptr && interrupt_solve->load() == true) {
+    MPSolutionResponse response;
+    response.set_status(MPSolverResponseStatus::MPSOLVER_NOT_SOLVED);
+    return response;
+  }
+
+  std::vector<MPModelRequest> racer_requests;
+  racer_requests.reserve(kNumRacers);
+  for (int racer = 0; racer < kNumRacers; ++racer) {
+    racer_requests.push_back(RacerRequest(request, static_cast<Racer>(racer)));
+  }
+
+  // The Glop racers are interrupted through their MPSolver, and PDLP through
+  // stop_race. Both are set once a racer has a conclusive status.
+  std::unique_ptr<MPSolver> glop_solvers[2];
+  for (const Racer racer : {kGlopPrimal, kGlopDual}) {
+    glop_solvers[racer] = std::make_unique<MPSolver>(
+        request.model().name(), MPSolver::GLOP_LINEAR_PROGRAMMING);
+  }
+  std::atomic<bool> stop_race = false;
+  std::vector<RacerResult> results(kNumRacers);
+  RaceState state;
+  const auto report = [&](int racer, RacerResult result) {
+    absl::MutexLock lock(&state.mutex);
+    if (state.winner < 0 && result.response.ok() &&
+        IsConclusive(result.response->status())) {
+      state.winner = racer;
+      stop_race = true;
+    }
+    results[racer] = std::move(result);
+    ++state.num_finished;
+  };
+
+  {
+    ThreadPool pool("ConcurrentLp", kNumRacers);
+    pool.StartWorkers();
+    for (const Racer racer : {kGlopPrimal, kGlopDual}) {
+      pool.Schedule([&, racer]() {
+        report(racer, SolveGlopRacer(racer_requests[racer], glop_parameters,
+                                     glop_solvers[racer].get()));
+      });
+    }
+    pool.Schedule([&]() {
+      report(kPdlp, SolvePdlpRacer(racer_requests[kPdlp], &stop_race));
+    });
+
+    // Forward the user interruption while waiting for a winner.
+    constexpr absl::Duration kInterruptPollDelay = absl::Milliseconds(1);
+    absl::MutexLock lock(&state.mutex);
+    while (!state.mutex.AwaitWithTimeout(
+        absl::Condition(&state, &RaceState::Done), kInterruptPollDelay)) {
+      if (interrupt_solve != nullptr && interrupt_solve->load()) {
+        stop_race = true;
+      }
+      if (stop_race) break;
+    }
+    stop_race = true;
+
+    // Interrupt the racers that lost. A Glop solve resets its interruption
+    // when it starts, so this is repeated until they are all done.
+    while (!state.mutex.AwaitWithTimeout(
+        absl::Condition(&state, &RaceState::AllFinished),
+        kInterruptPollDelay)) {
+      for (const Racer racer : {kGlopPrimal, kGlopDual}) {
+        glop_solvers[racer]->InterruptSolve();
+      }
+    }
+  }
+
+  absl::MutexLock lock(&state.mutex);
+  if (state.winner < 0) {
+    for (RacerResult& result : results) {
+      if (result.response.ok() &&
+          result.response->status() == MPSOLVER_FEASIBLE) {
+        if (solve_info != nullptr) *solve_info = std::move(result.info);
+        return std::move(result.response);
+      }
+    }
+    // The Glop racers always return a response; it carries the invalid model
+    // or limit status.
+    RacerResult& result = results[kGlopPrimal];
+    if (solve_info != nullptr) *solve_info = std::move(result.info);
+    MPSolutionResponse response = *std::move(result.response);
+    if (interrupt_solve != nullptr && interrupt_solve->load()) {
+      response.set_status(MPSOLVER_CANCELLED_BY_USER);
+    }
+    return response;
+  }
+
+  const int winner = state.winner;
+  LOG_IF(INFO, request.enable_internal_solver_output())
+      << kRacerNames[winner] << " won the concurrent LP race in "
+      << absl::Now() - start_time << ".";
+  MPSolutionResponse response = *std::move(results[winner].response);
+  ConcurrentLpSolveInfo info = std::move(results[winner].info);
+  absl::Duration time_limit = absl::InfiniteDuration();
+  if (request.has_solver_time_limit_seconds()) {
+    time_limit = absl::Seconds(request.solver_time_limit_seconds()) -
+                 (absl::Now() - start_time);
+  }
+  if (crossover && winner == kPdlp && response.status() == MPSOLVER_OPTIMAL &&
+      (interrupt_solve == nullptr || !interrupt_solve->load()) &&
+      time_limit > absl::ZeroDuration()) {
+    MPSolutionResponse crossover_response;
+    if (CrossoverWithGlop(racer_requests[kGlopPrimal], response, time_limit,
+                          &crossover_response, &info)) {
+      response = std::move(crossover_response);
+    }
+  }
+  if (solve_info != nullptr) *solve_info = std::move(info);
+  return response;
+}
+
+}  // namespace operations_research
@@ -0,0 +1,83 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_LINEAR_SOLVER_CONCURRENT_LP_H_
+#define OR_TOOLS_LINEAR_SOLVER_CONCURRENT_LP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "ortools/linear_solver/linear_solver.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+
+namespace operations_research {
+
+// What ConcurrentLpSolveProto() knows about the solution it returns, beyond
+// the MPSolutionResponse.
+struct ConcurrentLpSolveInfo {
+  // Number of iterations of the racer that won, plus the ones of the crossover
+  // if it produced the solution. This is kUnknownNumberOfIterations if no
+  // racer returned a solution.
+  int64_t iterations = MPSolverInterface::kUnknownNumberOfIterations;
+
+  // The basis of the returned solution, indexed like the variables and the
+  // constraints of the model. These are empty if there is no solution. When
+  // the solution comes from PDLP without crossover, the basis is guessed from
+  // it: the variables and constraints at one of their bounds are non-basic,
+  // the others basic.
+  std::vector<MPSolver::BasisStatus> variable_statuses;
+  std::vector<MPSolver::BasisStatus> constraint_statuses;
+};
+
+// Solves the LP specified by the MPModelRequest by racing, each in its own
+// thread, Glop's primal simplex, Glop's dual simplex and PDLP. As soon as one
+// of them proves optimality, infeasibility or unboundedness, the others are
+// interrupted and its response is returned. Which algorithm wins is very
+// problem dependent; this trades CPU time for a more predictable wall time.
+//
+// The request solver_type and solver_specific_parameters are ignored: each
+// racer uses its own default parameters, except that the given
+// glop_parameters, in the GlopParameters text format, are merged into the
+// parameters of the two Glop racers. The solver_time_limit_seconds applies to
+// the whole race. Integrality constraints are relaxed.
+//
+// If crossover is true and PDLP wins with an optimal solution, a Glop primal
+// simplex is started from a basis guessed from the PDLP solution (variables and
+// constraints at one of their bounds are non-basic, the others basic) to return
+// a vertex solution. The PDLP response is returned if this crossover does not
+// finish with an optimal status.
+//
+// The optional interrupt_solve can be used to interrupt the race early. If no
+// racer finished with a conclusive status, the status of the returned response
+// is then MPSOLVER_CANCELLED_BY_USER.
+//
+// Returns an error if the model is invalid for PDLP and the two Glop racers
+// did not reach a conclusive status. If solve_info is not null, it is filled
+// with the iteration count and the basis of the returned solution.
+//
+// This is also available through MPSolver with the
+// CONCURRENT_LINEAR_PROGRAMMING solver type (or "CONCURRENT_LP" in
+// MPSolver::CreateSolver()), in which case the crossover is requested with the
+// "crossover: true" solver specific parameters.
+absl::StatusOr<MPSolutionResponse> ConcurrentLpSolveProto(
+    const MPModelRequest& request, bool crossover = false,
+    const std::atomic<bool>* interrupt_solve = nullptr,
+    const std::string& glop_parameters = "",
+    ConcurrentLpSolveInfo* solve_info = nullptr);
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_LINEAR_SOLVER_CONCURRENT_LP_H_
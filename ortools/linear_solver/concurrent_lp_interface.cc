@@ -0,0 +1,392 @@
+// Copyright 2010-2022 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "ortools/base/logging.h"
+#include "ortools/glop/parameters.pb.h"
+#include "ortools/linear_solver/concurrent_lp.h"
+#include "ortools/linear_solver/linear_solver.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/port/proto_utils.h"
+
+namespace operations_research {
+
+namespace {
+
+// The only solver specific parameter of the concurrent LP solver is whether a
+// crossover is done when PDLP wins, given as "crossover: true" or
+// "crossover: false". An empty string keeps the current value.
+bool ParseCrossoverParameter(const std::string& parameters, bool* crossover) {
+  const std::string stripped = absl::StrReplaceAll(
+      absl::AsciiStrToLower(absl::StripAsciiWhitespace(parameters)),
+      {{" ", ""}});
+  if (stripped.empty()) return true;
+  if (stripped == "crossover:true") {
+    *crossover = true;
+    return true;
+  }
+  if (stripped == "crossover:false") {
+    *crossover = false;
+    return true;
+  }
+  LOG(WARNING) << "Unsupported concurrent LP parameters: " << parameters;
+  return false;
+}
+
+}  // namespace
+
+class ConcurrentLpInterface : public MPSolverInterface {
+ public:
+  explicit ConcurrentLpInterface(MPSolver* const solver);
+  ~ConcurrentLpInterface() override;
+
+  // ----- Solve -----
+  MPSolver::ResultStatus Solve(const MPSolverParameters& param) override;
+  std::optional<MPSolutionResponse> DirectlySolveProto(
+      const MPModelRequest& request, std::atomic<bool>* interrupt) override;
+  bool InterruptSolve() override;
+
+  // ----- Model modifications and extraction -----
+  void Reset() override;
+  void SetOptimizationDirection(bool maximize) override;
+  void SetVariableBounds(int index, double lb, double ub) override;
+  void SetVariableInteger(int index, bool integer) override;
+  void SetConstraintBounds(int index, double lb, double ub) override;
+  void AddRowConstraint(MPConstraint* const ct) override;
+  void AddVariable(MPVariable* const var) override;
+  void SetCoefficient(MPConstraint* const constraint,
+                      const MPVariable* const variable, double new_value,
+                      double old_value) override;
+  void ClearConstraint(MPConstraint* const constraint) override;
+  void SetObjectiveCoefficient(const MPVariable* const variable,
+                               double coefficient) override;
+  void SetObjectiveOffset(double value) override;
+  void ClearObjective() override;
+
+  // ------ Query statistics on the solution and the solve ------
+  int64_t iterations() const override;
+  int64_t nodes() const override;
+  MPSolver::BasisStatus row_status(int constraint_index) const override;
+  MPSolver::BasisStatus column_status(int variable_index) const override;
+
+  // ----- Misc -----
+  bool IsContinuous() const override;
+  bool IsLP() const override;
+  bool IsMIP() const override;
+
+  std::string SolverVersion() const override;
+  void* underlying_solver() override;
+
+  void ExtractNewVariables() override;
+  void ExtractNewConstraints() override;
+  void ExtractObjective() override;
+
+  void SetParameters(const MPSolverParameters& param) override;
+  void SetRelativeMipGap(double value) override;
+  void SetPrimalTolerance(double value) override;
+  void SetDualTolerance(double value) override;
+  void SetPresolveMode(int value) override;
+  void SetScalingMode(int value) override;
+  void SetLpAlgorithm(int value) override;
+  bool SetSolverSpecificParametersAsString(
+      const std::string& parameters) override;
+  absl::Status SetNumThreads(int num_threads) override;
+
+ private:
+  void NonIncrementalChange();
+
+  bool crossover_ = false;
+  // The MPSolverParameters forwarded to the two Glop racers.
+  glop::GlopParameters glop_parameters_;
+  ConcurrentLpSolveInfo solve_info_;
+  std::atomic<bool> interrupt_solver_;
+};
+
+ConcurrentLpInterface::ConcurrentLpInterface(MPSolver* const solver)
+    : MPSolverInterface(solver), interrupt_solver_(false) {}
+
+ConcurrentLpInterface::~ConcurrentLpInterface() {}
+
+MPSolver::ResultStatus ConcurrentLpInterface::Solve(
+    const MPSolverParameters& param) {
+  // Reset extraction as this interface is not incremental.
+  Reset();
+  ExtractModel();
+  SetParameters(param);
+  solver_->SetSolverSpecificParametersAsString(
+      solver_->solver_specific_parameter_string_);
+
+  // Mark variables and constraints as extracted.
+  for (int i = 0; i < solver_->variables_.size(); ++i) {
+    set_variable_as_extracted(i, true);
+  }
+  for (int i = 0; i < solver_->constraints_.size(); ++i) {
+    set_constraint_as_extracted(i, true);
+  }
+
+  MPModelRequest request;
+  solver_->ExportModelToProto(request.mutable_model());
+  request.set_enable_internal_solver_output(!quiet_);
+  if (solver_->time_limit()) {
+    VLOG(1) << "Setting time limit = " << solver_->time_limit() << " ms.";
+    request.set_solver_time_limit_seconds(solver_->time_limit_in_secs());
+  }
+  interrupt_solver_ = false;
+  absl::StatusOr<MPSolutionResponse> response = ConcurrentLpSolveProto(
+      request, crossover_, &interrupt_solver_,
+      ProtobufShortDebugString(glop_parameters_), &solve_info_);
+  if (!response.ok()) {
+    LOG(ERROR) << "Unexpected error in the concurrent LP solve: "
+               << response.status();
+    return MPSolver::ABNORMAL;
+  }
+
+  // The solution must be marked as synchronized even when no solution exists.
+  sync_status_ = SOLUTION_SYNCHRONIZED;
+  result_status_ = static_cast<MPSolver::ResultStatus>(response->status());
+  if (response->status() == MPSOLVER_FEASIBLE ||
+      response->status() == MPSOLVER_OPTIMAL) {
+    const absl::Status result = solver_->LoadSolutionFromProto(*response);
+    if (!result.ok()) {
+      LOG(ERROR) << "LoadSolutionFromProto failed: " << result;
+    }
+  }
+  return result_status_;
+}
+
+std::optional<MPSolutionResponse> ConcurrentLpInterface::DirectlySolveProto(
+    const MPModelRequest& request, std::atomic<bool>* interrupt) {
+  bool crossover = crossover_;
+  if (!ParseCrossoverParameter(request.solver_specific_parameters(),
+                               &crossover)) {
+    MPSolutionResponse error_response;
+    error_response.set_status(MPSOLVER_MODEL_INVALID_SOLVER_PARAMETERS);
+    error_response.set_status_str(absl::StrCat(
+        "Unsupported concurrent LP parameters: ",
+        request.solver_specific_parameters()));
+    return error_response;
+  }
+  absl::StatusOr<MPSolutionResponse> response =
+      ConcurrentLpSolveProto(request, crossover, interrupt);
+  if (!response.ok()) {
+    LOG(ERROR) << "Unexpected error in the concurrent LP solve: "
+               << response.status();
+    MPSolutionResponse error_response;
+    error_response.set_status(MPSolverResponseStatus::MPSOLVER_ABNORMAL);
+    error_response.set_status_str(response.status().ToString());
+    return error_response;
+  }
+  return *std::move(response);
+}
+
+bool ConcurrentLpInterface::InterruptSolve() {
+  interrupt_solver_ = true;
+  return true;
+}
+
+void ConcurrentLpInterface::Reset() { ResetExtractionInformation(); }
+
+void ConcurrentLpInterface::SetOptimizationDirection(bool maximize) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::SetVariableBounds(int index, double lb, double ub) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::SetVariableInteger(int index, bool integer) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::SetConstraintBounds(int index, double lb,
+                                                double ub) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::AddRowConstraint(MPConstraint* const ct) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::AddVariable(MPVariable* const var) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::SetCoefficient(MPConstraint* const constraint,
+                                           const MPVariable* const variable,
+                                           double new_value, double old_value) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::ClearConstraint(MPConstraint* const constraint) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::SetObjectiveCoefficient(
+    const MPVariable* const variable, double coefficient) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::SetObjectiveOffset(double value) {
+  NonIncrementalChange();
+}
+
+void ConcurrentLpInterface::ClearObjective() { NonIncrementalChange(); }
+
+int64_t ConcurrentLpInterface::iterations() const {
+  if (!CheckSolutionIsSynchronized()) return kUnknownNumberOfIterations;
+  return solve_info_.iterations;
+}
+
+int64_t ConcurrentLpInterface::nodes() const {
+  LOG(DFATAL) << "Number of nodes only available for discrete problems";
+  return MPSolverInterface::kUnknownNumberOfNodes;
+}
+
+// Note that when PDLP won without crossover, the basis is guessed from its
+// solution, see ConcurrentLpSolveInfo.
+MPSolver::BasisStatus ConcurrentLpInterface::row_status(
+    int constraint_index) const {
+  if (constraint_index >= solve_info_.constraint_statuses.size()) {
+    LOG(DFATAL) << "No basis status for constraint " << constraint_index;
+    return MPSolver::BasisStatus::FREE;
+  }
+  return solve_info_.constraint_statuses[constraint_index];
+}
+
+MPSolver::BasisStatus ConcurrentLpInterface::column_status(
+    int variable_index) const {
+  if (variable_index >= solve_info_.variable_statuses.size()) {
+    LOG(DFATAL) << "No basis status for variable " << variable_index;
+    return MPSolver::BasisStatus::FREE;
+  }
+  return solve_info_.variable_statuses[variable_index];
+}
+
+bool ConcurrentLpInterface::IsContinuous() const { return true; }
+
+bool ConcurrentLpInterface::IsLP() const { return true; }
+
+bool ConcurrentLpInterface::IsMIP() const { return false; }
+
+std::string ConcurrentLpInterface::SolverVersion() const {
+  return "Concurrent LP Solver (Glop primal, Glop dual and PDLP)";
+}
+
+void* ConcurrentLpInterface::underlying_solver() { return nullptr; }
+
+void ConcurrentLpInterface::ExtractNewVariables() { NonIncrementalChange(); }
+
+void ConcurrentLpInterface::ExtractNewConstraints() { NonIncrementalChange(); }
+
+void ConcurrentLpInterface::ExtractObjective() { NonIncrementalChange(); }
+
+void ConcurrentLpInterface::SetParameters(const MPSolverParameters& param) {
+  glop_parameters_.Clear();
+  SetCommonParameters(param);
+  SetScalingMode(param.GetIntegerParam(MPSolverParameters::SCALING));
+}
+
+// The race always uses one thread per racer.
+absl::Status ConcurrentLpInterface::SetNumThreads(int num_threads) {
+  if (num_threads < 1) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid number of threads: ", num_threads));
+  }
+  return absl::OkStatus();
+}
+
+// The racers keep their own default tolerances, which differ between Glop and
+// PDLP, so only the default values are accepted.
+void ConcurrentLpInterface::SetPrimalTolerance(double value) {
+  if (value != MPSolverParameters::kDefaultPrimalTolerance) {
+    SetDoubleParamToUnsupportedValue(MPSolverParameters::PRIMAL_TOLERANCE,
+                                     value);
+  }
+}
+
+void ConcurrentLpInterface::SetDualTolerance(double value) {
+  if (value != MPSolverParameters::kDefaultDualTolerance) {
+    SetDoubleParamToUnsupportedValue(MPSolverParameters::DUAL_TOLERANCE, value);
+  }
+}
+
+// The presolve and scaling modes are forwarded to the Glop racers. PDLP does
+// not use a presolve by default and its scaling is part of the algorithm.
+void ConcurrentLpInterface::SetPresolveMode(int value) {
+  switch (value) {
+    case MPSolverParameters::PRESOLVE_OFF:
+      glop_parameters_.set_use_preprocessing(false);
+      break;
+    case MPSolverParameters::PRESOLVE_ON:
+      glop_parameters_.set_use_preprocessing(true);
+      break;
+    default:
+      if (value != MPSolverParameters::kDefaultIntegerParamValue) {
+        SetIntegerParamToUnsupportedValue(MPSolverParameters::PRESOLVE, value);
+      }
+  }
+}
+
+void ConcurrentLpInterface::SetScalingMode(int value) {
+  switch (value) {
+    case MPSolverParameters::SCALING_OFF:
+      glop_parameters_.set_use_scaling(false);
+      break;
+    case MPSolverParameters::SCALING_ON:
+      glop_parameters_.set_use_scaling(true);
+      break;
+    default:
+      if (value != MPSolverParameters::kDefaultIntegerParamValue) {
+        SetIntegerParamToUnsupportedValue(MPSolverParameters::SCALING, value);
+      }
+  }
+}
+
+// Choosing the algorithm would defeat the race.
+void ConcurrentLpInterface::SetLpAlgorithm(int value) {
+  SetIntegerParamToUnsupportedValue(MPSolverParameters::LP_ALGORITHM, value);
+}
+
+void ConcurrentLpInterface::SetRelativeMipGap(double value) {
+  if (value != MPSolverParameters::kDefaultDoubleParamValue) {
+    SetDoubleParamToUnsupportedValue(MPSolverParameters::RELATIVE_MIP_GAP,
+                                     value);
+  }
+}
+
+bool ConcurrentLpInterface::SetSolverSpecificParametersAsString(
+    const std::string& parameters) {
+  return ParseCrossoverParameter(parameters, &crossover_);
+}
+
+void ConcurrentLpInterface::NonIncrementalChange() {
+  // The current implementation is not incremental.
+  sync_status_ = MUST_RELOAD;
+}
+
+// Register the concurrent LP solver in the global linear solver factory.
+MPSolverInterface* BuildConcurrentLpInterface(MPSolver* const solver) {
+  return new ConcurrentLpInterface(solver);
+}
+
+}  // namespace operations_research
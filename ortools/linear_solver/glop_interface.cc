@@ -91,8 +91,9 @@ class GLOPInterface : public MPSolverInterface {
       const std::string& parameters) override;
 
  private:
-  void NonIncrementalChange();
-
+  // The LinearProgram is kept in sync with the MPSolver model between solves,
+  // so that the LPSolver can warm-start from its last basis, factorization and
+  // edge norms.
   glop::LinearProgram linear_program_;
   glop::LPSolver lp_solver_;
   std::vector<MPSolver::BasisStatus> column_status_;
@@ -113,10 +114,13 @@ GLOPInterface::GLOPInterface(MPSolver* const solver)
 GLOPInterface::~GLOPInterface() {}
 
 MPSolver::ResultStatus GLOPInterface::Solve(const MPSolverParameters& param) {
-  // Re-extract the problem from scratch. We don't support modifying the
-  // LinearProgram in sync with changes done in the MPSolver.
-  ResetExtractionInformation();
-  linear_program_.Clear();
+  // Reset extraction and warm-start information if the user doesn't want
+  // incrementality. Otherwise, only the new variables and constraints need to
+  // be extracted, the other changes were already applied to linear_program_.
+  if (param.GetIntegerParam(MPSolverParameters::INCREMENTALITY) ==
+      MPSolverParameters::INCREMENTALITY_OFF) {
+    Reset();
+  }
   interrupt_solver_ = false;
   ExtractModel();
   SetParameters(param);
@@ -191,14 +195,22 @@ void GLOPInterface::Reset() {
   // Ignore any incremental info for the next solve. Note that the parameters
   // will not be reset as we re-read them on each Solve().
   lp_solver_.Clear();
+  linear_program_.Clear();
+  ResetExtractionInformation();
 }
 
 void GLOPInterface::SetOptimizationDirection(bool maximize) {
-  NonIncrementalChange();
+  InvalidateSolutionSynchronization();
+  linear_program_.SetMaximizationProblem(maximize);
 }
 
 void GLOPInterface::SetVariableBounds(int index, double lb, double ub) {
-  NonIncrementalChange();
+  InvalidateSolutionSynchronization();
+  if (variable_is_extracted(index)) {
+    linear_program_.SetVariableBounds(glop::ColIndex(index), lb, ub);
+  } else {
+    sync_status_ = MUST_RELOAD;
+  }
 }
 
 void GLOPInterface::SetVariableInteger(int index, bool integer) {
@@ -206,35 +218,79 @@ void GLOPInterface::SetVariableInteger(int index, bool integer) {
 }
 
 void GLOPInterface::SetConstraintBounds(int index, double lb, double ub) {
-  NonIncrementalChange();
+  InvalidateSolutionSynchronization();
+  if (constraint_is_extracted(index)) {
+    linear_program_.SetConstraintBounds(glop::RowIndex(index), lb, ub);
+  } else {
+    sync_status_ = MUST_RELOAD;
+  }
 }
 
 void GLOPInterface::AddRowConstraint(MPConstraint* const ct) {
-  NonIncrementalChange();
+  sync_status_ = MUST_RELOAD;
 }
 
 void GLOPInterface::AddVariable(MPVariable* const var) {
-  NonIncrementalChange();
+  sync_status_ = MUST_RELOAD;
 }
 
 void GLOPInterface::SetCoefficient(MPConstraint* const constraint,
                                    const MPVariable* const variable,
                                    double new_value, double old_value) {
-  NonIncrementalChange();
+  InvalidateSolutionSynchronization();
+  if (constraint_is_extracted(constraint->index()) &&
+      variable_is_extracted(variable->index())) {
+    // Note that linear_program_.CleanUp() in Solve() keeps the last value set
+    // for a given entry and removes the zeros.
+    linear_program_.SetCoefficient(glop::RowIndex(constraint->index()),
+                                   glop::ColIndex(variable->index()),
+                                   new_value);
+  } else {
+    // The coefficient will be set when the new variable or constraint is
+    // extracted.
+    sync_status_ = MUST_RELOAD;
+  }
 }
 
 void GLOPInterface::ClearConstraint(MPConstraint* const constraint) {
-  NonIncrementalChange();
+  InvalidateSolutionSynchronization();
+  // Constraint may not have been extracted yet.
+  if (!constraint_is_extracted(constraint->index())) return;
+  const glop::RowIndex row(constraint->index());
+  for (const auto& entry : constraint->coefficients_) {
+    const int var_index = entry.first->index();
+    if (variable_is_extracted(var_index)) {
+      linear_program_.SetCoefficient(row, glop::ColIndex(var_index), 0.0);
+    }
+  }
 }
 
 void GLOPInterface::SetObjectiveCoefficient(const MPVariable* const variable,
                                             double coefficient) {
-  NonIncrementalChange();
+  InvalidateSolutionSynchronization();
+  if (variable_is_extracted(variable->index())) {
+    linear_program_.SetObjectiveCoefficient(glop::ColIndex(variable->index()),
+                                            coefficient);
+  } else {
+    sync_status_ = MUST_RELOAD;
+  }
 }
 
-void GLOPInterface::SetObjectiveOffset(double value) { NonIncrementalChange(); }
+void GLOPInterface::SetObjectiveOffset(double value) {
+  InvalidateSolutionSynchronization();
+  linear_program_.SetObjectiveOffset(value);
+}
 
-void GLOPInterface::ClearObjective() { NonIncrementalChange(); }
+void GLOPInterface::ClearObjective() {
+  InvalidateSolutionSynchronization();
+  for (const auto& entry : solver_->objective_->coefficients_) {
+    const int var_index = entry.first->index();
+    if (variable_is_extracted(var_index)) {
+      linear_program_.SetObjectiveCoefficient(glop::ColIndex(var_index), 0.0);
+    }
+  }
+  linear_program_.SetObjectiveOffset(0.0);
+}
 
 int64_t GLOPInterface::iterations() const {
   return lp_solver_.GetNumberOfSimplexIterations();
@@ -266,9 +322,6 @@ std::string GLOPInterface::SolverVersion() const {
 void* GLOPInterface::underlying_solver() { return &lp_solver_; }
 
 void GLOPInterface::ExtractNewVariables() {
-  DCHECK_EQ(0, last_variable_index_);
-  DCHECK_EQ(0, last_constraint_index_);
-
   const glop::ColIndex num_cols(solver_->variables_.size());
   for (glop::ColIndex col(last_variable_index_); col < num_cols; ++col) {
     MPVariable* const var = solver_->variables_[col.value()];
@@ -277,13 +330,26 @@ void GLOPInterface::ExtractNewVariables() {
     set_variable_as_extracted(col.value(), true);
     linear_program_.SetVariableBounds(col, var->lb(), var->ub());
   }
+
+  // Add the new variables to the already extracted constraints.
+  if (num_cols == last_variable_index_) return;
+  for (int i = 0; i < last_constraint_index_; ++i) {
+    MPConstraint* const ct = solver_->constraints_[i];
+    const glop::RowIndex row(ct->index());
+    for (const auto& entry : ct->coefficients_) {
+      const int var_index = entry.first->index();
+      DCHECK(variable_is_extracted(var_index));
+      if (var_index >= last_variable_index_) {
+        linear_program_.SetCoefficient(row, glop::ColIndex(var_index),
+                                       entry.second);
+      }
+    }
+  }
 }
 
 void GLOPInterface::ExtractNewConstraints() {
-  DCHECK_EQ(0, last_constraint_index_);
-
   const glop::RowIndex num_rows(solver_->constraints_.size());
-  for (glop::RowIndex row(0); row < num_rows; ++row) {
+  for (glop::RowIndex row(last_constraint_index_); row < num_rows; ++row) {
     MPConstraint* const ct = solver_->constraints_[row.value()];
     set_constraint_as_extracted(row.value(), true);
 
@@ -330,6 +396,13 @@ void GLOPInterface::SetStartingLpBasis(
 void GLOPInterface::SetParameters(const MPSolverParameters& param) {
   parameters_.Clear();
   parameters_.set_log_search_progress(!quiet_);
+
+  // On incremental solves, unless an algorithm was explicitly requested, let
+  // Glop pick the dual (resp. primal) simplex when only the bounds (resp. the
+  // objective) changed so that it can start from the previous optimal basis.
+  parameters_.set_allow_simplex_algorithm_change(
+      param.GetIntegerParam(MPSolverParameters::LP_ALGORITHM) ==
+      MPSolverParameters::kDefaultIntegerParamValue);
   SetCommonParameters(param);
   SetScalingMode(param.GetIntegerParam(MPSolverParameters::SCALING));
 }
@@ -419,11 +492,6 @@ bool GLOPInterface::SetSolverSpecificParametersAsString(
   return false;
 }
 
-void GLOPInterface::NonIncrementalChange() {
-  // The current implementation is not incremental.
-  sync_status_ = MUST_RELOAD;
-}
-
 // Register GLOP in the global linear solver factory.
 MPSolverInterface* BuildGLOPInterface(MPSolver* const solver) {
   return new GLOPInterface(solver);
@@ -75,6 +75,7 @@ namespace operations_research {
 bool SolverTypeIsMip(MPModelRequest::SolverType solver_type) {
   switch (solver_type) {
     case MPModelRequest::PDLP_LINEAR_PROGRAMMING:
+    case MPModelRequest::CONCURRENT_LINEAR_PROGRAMMING:
     case MPModelRequest::GLOP_LINEAR_PROGRAMMING:
     case MPModelRequest::CLP_LINEAR_PROGRAMMING:
     case MPModelRequest::GLPK_LINEAR_PROGRAMMING:
@@ -379,6 +380,7 @@ extern MPSolverInterface* BuildHighsInterface(bool mip, MPSolver* const solver);
 extern MPSolverInterface* BuildBopInterface(MPSolver* const solver);
 extern MPSolverInterface* BuildGLOPInterface(MPSolver* const solver);
 extern MPSolverInterface* BuildPdlpInterface(MPSolver* const solver);
+extern MPSolverInterface* BuildConcurrentLpInterface(MPSolver* const solver);
 extern MPSolverInterface* BuildSatInterface(MPSolver* const solver);
 #if defined(USE_SCIP)
 extern MPSolverInterface* BuildSCIPInterface(MPSolver* const solver);
@@ -403,6 +405,8 @@ MPSolverInterface* BuildSolverInterface(MPSolver* const solver) {
       return BuildGLOPInterface(solver);
     case MPSolver::PDLP_LINEAR_PROGRAMMING:
       return BuildPdlpInterface(solver);
+    case MPSolver::CONCURRENT_LINEAR_PROGRAMMING:
+      return BuildConcurrentLpInterface(solver);
     case MPSolver::SAT_INTEGER_PROGRAMMING:
       return BuildSatInterface(solver);
 #if defined(USE_CLP) || defined(USE_CBC)
@@ -502,6 +506,7 @@ bool MPSolver::SupportsProblemType(OptimizationProblemType problem_type) {
   if (problem_type == SAT_INTEGER_PROGRAMMING) return true;
   if (problem_type == GLOP_LINEAR_PROGRAMMING) return true;
   if (problem_type == PDLP_LINEAR_PROGRAMMING) return true;
+  if (problem_type == CONCURRENT_LINEAR_PROGRAMMING) return true;
   if (problem_type == GUROBI_LINEAR_PROGRAMMING ||
       problem_type == GUROBI_MIXED_INTEGER_PROGRAMMING) {
     return GurobiIsCorrectlyInstalled();
@@ -559,6 +564,7 @@ constexpr
         {MPSolver::GLPK_MIXED_INTEGER_PROGRAMMING, "glpk"},
         {MPSolver::HIGHS_MIXED_INTEGER_PROGRAMMING, "highs"},
         {MPSolver::PDLP_LINEAR_PROGRAMMING, "pdlp"},
+        {MPSolver::CONCURRENT_LINEAR_PROGRAMMING, "concurrent_lp"},
         {MPSolver::KNAPSACK_MIXED_INTEGER_PROGRAMMING, "knapsack"},
         {MPSolver::CPLEX_MIXED_INTEGER_PROGRAMMING, "cplex"},
         {MPSolver::XPRESS_MIXED_INTEGER_PROGRAMMING, "xpress"},
@@ -200,6 +200,9 @@ class MPSolver {
     // scales to much larger problems than Glop.
     PDLP_LINEAR_PROGRAMMING = 8,
     HIGHS_LINEAR_PROGRAMMING = 15,
+    // Races GLOP_LINEAR_PROGRAMMING with the primal and the dual simplex and
+    // PDLP_LINEAR_PROGRAMMING, each in its own thread.
+    CONCURRENT_LINEAR_PROGRAMMING = 17,
 
     // Integer programming problems.
     // -----------------------------
@@ -252,6 +255,8 @@ class MPSolver {
    *   - CLP_LINEAR_PROGRAMMING or CLP
    *   - CBC_MIXED_INTEGER_PROGRAMMING or CBC
    *   - GLOP_LINEAR_PROGRAMMING or GLOP
+   *   - PDLP_LINEAR_PROGRAMMING or PDLP
+   *   - CONCURRENT_LINEAR_PROGRAMMING or CONCURRENT_LP
    *   - BOP_INTEGER_PROGRAMMING or BOP
    *   - SAT_INTEGER_PROGRAMMING or SAT or CP_SAT
    *   - SCIP_MIXED_INTEGER_PROGRAMMING or SCIP
@@ -577,7 +582,8 @@ class MPSolver {
            solver == MPModelRequest::GUROBI_LINEAR_PROGRAMMING ||
            solver == MPModelRequest::GUROBI_MIXED_INTEGER_PROGRAMMING ||
            solver == MPModelRequest::SAT_INTEGER_PROGRAMMING ||
-           solver == MPModelRequest::PDLP_LINEAR_PROGRAMMING;
+           solver == MPModelRequest::PDLP_LINEAR_PROGRAMMING ||
+           solver == MPModelRequest::CONCURRENT_LINEAR_PROGRAMMING;
   }
 
   /// Exports model to protocol buffer.
@@ -858,6 +864,7 @@ class MPSolver {
   friend class BopInterface;
   friend class SatInterface;
   friend class PdlpInterface;
+  friend class ConcurrentLpInterface;
   friend class HighsInterface;
   friend class KnapsackInterface;
 
@@ -1079,6 +1086,7 @@ class MPObjective {
   friend class BopInterface;
   friend class SatInterface;
   friend class PdlpInterface;
+  friend class ConcurrentLpInterface;
   friend class HighsInterface;
   friend class KnapsackInterface;
 
@@ -1190,6 +1198,7 @@ class MPVariable {
   friend class BopInterface;
   friend class SatInterface;
   friend class PdlpInterface;
+  friend class ConcurrentLpInterface;
   friend class HighsInterface;
   friend class KnapsackInterface;
 
@@ -1333,6 +1342,7 @@ class MPConstraint {
   friend class BopInterface;
   friend class SatInterface;
   friend class PdlpInterface;
+  friend class ConcurrentLpInterface;
   friend class HighsInterface;
   friend class KnapsackInterface;
 
@@ -228,6 +228,35 @@ class PyWrapLpTest(unittest.TestCase):
         self.assertEqual(2, len(solver.variables()))
         self.assertEqual(1, len(solver.constraints()))
 
+    def testConcurrentLp(self):
+        print('testConcurrentLp', flush=True)
+
+        def solve(problem_type, parameters=''):
+            solver = pywraplp.Solver('testConcurrentLp', problem_type)
+            infinity = solver.infinity()
+            x1 = solver.NumVar(0.0, infinity, 'x1')
+            x2 = solver.NumVar(0.0, infinity, 'x2')
+            x3 = solver.NumVar(0.0, infinity, 'x3')
+            solver.Maximize(10 * x1 + 6 * x2 + 4 * x3)
+            solver.Add(10 * x1 + 4 * x2 + 5 * x3 <= 600)
+            solver.Add(2 * x1 + 2 * x2 + 6 * x3 <= 300)
+            solver.Add(x1 + x2 + x3 <= 100.0)
+            self.assertTrue(solver.SetSolverSpecificParametersAsString(parameters))
+            self.assertEqual(pywraplp.Solver.OPTIMAL, solver.Solve())
+            basis = ([v.basis_status() for v in solver.variables()] +
+                     [c.basis_status() for c in solver.constraints()])
+            return solver.Objective().Value(), solver.iterations(), basis
+
+        glop_objective, _, glop_basis = solve(
+            pywraplp.Solver.GLOP_LINEAR_PROGRAMMING)
+        # With the crossover, the winner always returns a vertex solution, and
+        # this problem has a unique optimal basis.
+        objective, iterations, basis = solve(
+            pywraplp.Solver.CONCURRENT_LINEAR_PROGRAMMING, 'crossover: true')
+        self.assertAlmostEqual(glop_objective, objective, places=4)
+        self.assertGreaterEqual(iterations, 0)
+        self.assertEqual(glop_basis, basis)
+
     def testBopInfeasible(self):
         print('testBopInfeasible', flush=True)
         solver = pywraplp.Solver('test', pywraplp.Solver.BOP_INTEGER_PROGRAMMING)
@@ -532,6 +532,8 @@ void TriangularMatrix::PopulateFromTranspose(const TriangularMatrix& input) {
   // This takes care of the triangular special case.
   diagonal_coefficients_ = input.diagonal_coefficients_;
   all_diagonal_coefficients_are_one_ = input.all_diagonal_coefficients_are_one_;
+  level_starts_.clear();
+  level_columns_.clear();
 
   // The elimination structure of the transpose is not the same.
   pruned_ends_.resize(num_cols_, EntryIndex(0));
@@ -563,6 +565,8 @@ void TriangularMatrix::Reset(RowIndex num_rows, ColIndex col_capacity) {
   CompactSparseMatrix::Reset(num_rows);
   first_non_identity_column_ = 0;
   all_diagonal_coefficients_are_one_ = true;
+  level_starts_.clear();
+  level_columns_.clear();
 
   pruned_ends_.resize(col_capacity);
   diagonal_coefficients_.resize(col_capacity);
@@ -634,6 +638,8 @@ void TriangularMatrix::Swap(TriangularMatrix* other) {
   std::swap(first_non_identity_column_, other->first_non_identity_column_);
   std::swap(all_diagonal_coefficients_are_one_,
             other->all_diagonal_coefficients_are_one_);
+  level_starts_.swap(other->level_starts_);
+  level_columns_.swap(other->level_columns_);
 }
 
 EntryIndex CompactSparseMatrixView::num_entries() const {
@@ -753,6 +759,8 @@ void TriangularMatrix::ApplyRowPermutationToNonDiagonalEntries(
   for (EntryIndex i(0); i < num_entries; ++i) {
     rows_[i] = row_perm[rows_[i]];
   }
+  level_starts_.clear();
+  level_columns_.clear();
 }
 
 void TriangularMatrix::CopyColumnToSparseColumn(ColIndex col,
@@ -953,6 +961,87 @@ void TriangularMatrix::TransposeLowerSolveInternal(
   }
 }
 
+void TriangularMatrix::ComputeLevelSchedule() {
+  const ColIndex num_cols = num_cols_;
+  level_starts_.clear();
+  level_columns_.clear();
+  if (num_cols == 0) return;
+
+  // A transpose solve of an upper (resp. lower) triangular matrix processes
+  // the columns in increasing (resp. decreasing) order. We detect the case
+  // from the first non-diagonal entry, an identity matrix can use any order.
+  const auto entry_rows = rows_.view();
+  bool is_upper = true;
+  if (!rows_.empty()) {
+    for (ColIndex col(0); col < num_cols; ++col) {
+      if (ColumnIsEmpty(col)) continue;
+      is_upper = entry_rows[starts_[col]] < ColToRowIndex(col);
+      break;
+    }
+  }
+
+  // The level of a column is one more than the maximum level of the columns it
+  // depends on, they are all processed before it in the chosen order.
+  std::vector<int> level(num_cols.value(), 0);
+  int num_levels = 1;
+  for (ColIndex i(0); i < num_cols; ++i) {
+    const ColIndex col = is_upper ? i : num_cols - 1 - i;
+    int col_level = 0;
+    for (const EntryIndex e : Column(col)) {
+      col_level = std::max(col_level, level[entry_rows[e].value()] + 1);
+    }
+    level[col.value()] = col_level;
+    num_levels = std::max(num_levels, col_level + 1);
+  }
+
+  // Counting sort of the columns by level.
+  level_starts_.assign(num_levels + 1, 0);
+  for (const int l : level) ++level_starts_[l + 1];
+  for (int l = 0; l < num_levels; ++l) {
+    level_starts_[l + 1] += level_starts_[l];
+  }
+  std::vector<int> positions(level_starts_.begin(), level_starts_.end() - 1);
+  level_columns_.resize(num_cols.value());
+  for (ColIndex col(0); col < num_cols; ++col) {
+    level_columns_[positions[level[col.value()]]++] = col;
+  }
+}
+
+void TriangularMatrix::TransposeSolveWithLevels(DenseColumn* rhs,
+                                                int num_threads) const {
+  RETURN_IF_NULL(rhs);
+  DCHECK(HasLevelSchedule());
+#ifdef OMP
+  // It is not worth waking up the threads for small levels.
+  const int kMinColumnsPerThread = 64;
+#endif
+
+  DenseColumn::View values = rhs->view();
+  const auto entry_rows = rows_.view();
+  const auto entry_coefficients = coefficients_.view();
+  const auto diagonal_coefficients = diagonal_coefficients_.view();
+  const bool diagonal_of_ones = all_diagonal_coefficients_are_one_;
+  const int num_levels = NumLevels();
+  for (int l = 0; l < num_levels; ++l) {
+    const int begin = level_starts_[l];
+    const int end = level_starts_[l + 1];
+#ifdef OMP
+#pragma omp parallel for num_threads(num_threads) if ( \
+        num_threads > 1 && end - begin >= kMinColumnsPerThread * num_threads)
+#endif
+    for (int k = begin; k < end; ++k) {
+      const ColIndex col = level_columns_[k];
+      Fractional sum = values[ColToRowIndex(col)];
+      const EntryIndex i_end = starts_[col + 1];
+      for (EntryIndex i = starts_[col]; i < i_end; ++i) {
+        sum -= entry_coefficients[i] * values[entry_rows[i]];
+      }
+      values[ColToRowIndex(col)] =
+          diagonal_of_ones ? sum : sum / diagonal_coefficients[col];
+    }
+  }
+}
+
 void TriangularMatrix::HyperSparseSolve(DenseColumn* rhs,
                                         RowIndexVector* non_zero_rows) const {
   RETURN_IF_NULL(rhs);
@@ -684,6 +684,31 @@ class TriangularMatrix : private CompactSparseMatrix {
   // This can be used to do a left-solve for a row vector (i.e., y.Y = rhs).
   void TransposeLowerSolve(DenseColumn* rhs) const;
 
+  // Level-scheduled version of TransposeUpperSolve() and TransposeLowerSolve().
+  //
+  // In a transpose solve, the value of the column col only depends on the
+  // values of the rows of its non-diagonal entries. The columns can thus be
+  // partitioned into levels such that all the columns of a given level only
+  // depend on the columns of the previous levels. ComputeLevelSchedule() must
+  // be called once the matrix is fully constructed, and the solve then
+  // processes the columns level by level, using up to num_threads OMP threads
+  // inside each level. The result only differs from the one of the
+  // non-parallel transpose solve by the order of the floating-point additions.
+  //
+  // Since L.x = b is the same as Transpose(Transpose(L)).x = b, this can also
+  // be used to perform a LowerSolve() (resp. UpperSolve()) with the transpose
+  // of the lower (resp. upper) matrix.
+  void ComputeLevelSchedule();
+  void ClearLevelSchedule() {
+    level_starts_.clear();
+    level_columns_.clear();
+  }
+  bool HasLevelSchedule() const { return !level_starts_.empty(); }
+  int NumLevels() const {
+    return level_starts_.empty() ? 0 : level_starts_.size() - 1;
+  }
+  void TransposeSolveWithLevels(DenseColumn* rhs, int num_threads) const;
+
   // Hyper-sparse version of the triangular solve functions. The passed
   // non_zero_rows should contain the positions of the symbolic non-zeros of the
   // result in the order in which they need to be accessed (or in the reverse
@@ -866,6 +891,13 @@ class TriangularMatrix : private CompactSparseMatrix {
   mutable std::vector<RowIndex> upper_column_rows_;
   mutable DenseColumn initially_all_zero_scratchpad_;
 
+  // For TransposeSolveWithLevels(). The columns of the level l are
+  // level_columns_[level_starts_[l]] to level_columns_[level_starts_[l + 1]]
+  // excluded. Both are empty if ComputeLevelSchedule() was not called since
+  // the last modification of the matrix.
+  std::vector<int> level_starts_;
+  std::vector<ColIndex> level_columns_;
+
   // This boolean vector is used to detect entries that can be pruned during
   // the DFS used for the symbolic phase of ComputeRowsToConsider().
   //
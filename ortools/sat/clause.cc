@@ -494,6 +494,7 @@ void LiteralWatchers::DeleteRemovedClauses() {
 
 void BinaryImplicationGraph::Resize(int num_variables) {
   SCOPED_TIME_STAT(&stats_);
+  compact_implications_are_valid_ = false;
   implications_.resize(num_variables << 1);
   is_redundant_.resize(implications_.size());
   is_removed_.resize(implications_.size(), false);
@@ -717,29 +718,49 @@ bool BinaryImplicationGraph::PropagateOnTrue(Literal true_literal,
   // Note(user): This update is not exactly correct because in case of conflict
   // we don't inspect that much clauses. But doing ++num_inspections_ inside the
   // loop does slow down the code by a few percent.
-  num_inspections_ += implications_[true_literal.Index()].size();
-
-  for (Literal literal : implications_[true_literal.Index()]) {
-    if (assignment.LiteralIsTrue(literal)) {
-      // Note(user): I tried to update the reason here if the literal was
-      // enqueued after the true_literal on the trail. This property is
-      // important for ComputeFirstUIPConflict() to work since it needs the
-      // trail order to be a topological order for the deduction graph.
-      // But the performance was not too good...
-      continue;
+  const LiteralIndex index = true_literal.Index();
+  const absl::InlinedVector<Literal, 6>& implications = implications_[index];
+  num_inspections_ += implications.size();
+
+  const auto propagate = [&](absl::Span<const Literal> implied_literals) {
+    for (const Literal literal : implied_literals) {
+      if (assignment.LiteralIsTrue(literal)) {
+        // Note(user): I tried to update the reason here if the literal was
+        // enqueued after the true_literal on the trail. This property is
+        // important for ComputeFirstUIPConflict() to work since it needs the
+        // trail order to be a topological order for the deduction graph.
+        // But the performance was not too good...
+        continue;
+      }
+
+      ++num_propagations_;
+      if (assignment.LiteralIsFalse(literal)) {
+        // Conflict.
+        *(trail->MutableConflict()) = {true_literal.Negated(), literal};
+        return false;
+      } else {
+        // Propagation.
+        reasons_[trail->Index()] = true_literal.Negated();
+        trail->Enqueue(literal, propagator_id_);
+      }
     }
+    return true;
+  };
 
-    ++num_propagations_;
-    if (assignment.LiteralIsFalse(literal)) {
-      // Conflict.
-      *(trail->MutableConflict()) = {true_literal.Negated(), literal};
+  // The first part of the list is scanned from its contiguous copy, and only
+  // the implications added since the last rebuild from the list itself.
+  int num_compacted = 0;
+  if (compact_implications_are_valid_) {
+    const int start = compact_starts_[index];
+    num_compacted = compact_starts_[LiteralIndex(index.value() + 1)] - start;
+    if (!propagate(absl::MakeConstSpan(compact_implications_.data() + start,
+                                       num_compacted))) {
       return false;
-    } else {
-      // Propagation.
-      reasons_[trail->Index()] = true_literal.Negated();
-      trail->Enqueue(literal, propagator_id_);
     }
   }
+  if (!propagate(absl::MakeConstSpan(implications).subspan(num_compacted))) {
+    return false;
+  }
 
   // Propagate the at_most_one constraints.
   if (true_literal.Index() < at_most_ones_.size()) {
@@ -782,6 +803,18 @@ bool BinaryImplicationGraph::Propagate(Trail* trail) {
     propagation_trail_index_ = trail->Index();
     return true;
   }
+
+  // Rebuild the compact copy if it is stale or if too many implications were
+  // added since the last rebuild. Note that we never do it at level zero,
+  // where DetectEquivalences() and the like can propagate in the middle of
+  // their modifications of implications_.
+  if (use_compact_implications_ && trail->CurrentDecisionLevel() > 0 &&
+      (!compact_implications_are_valid_ ||
+       num_implications_ - num_implications_at_last_rebuild_ >
+           num_implications_at_last_rebuild_ / 4)) {
+    RebuildCompactImplications();
+  }
+
   while (propagation_trail_index_ < trail->Index()) {
     const Literal literal = (*trail)[propagation_trail_index_++];
     if (!PropagateOnTrue(literal, trail)) return false;
@@ -789,6 +822,22 @@ bool BinaryImplicationGraph::Propagate(Trail* trail) {
   return true;
 }
 
+void BinaryImplicationGraph::RebuildCompactImplications() {
+  SCOPED_TIME_STAT(&stats_);
+  const int num_literals = implications_.size();
+  compact_starts_.resize(num_literals + 1);
+  compact_implications_.clear();
+  for (LiteralIndex i(0); i < num_literals; ++i) {
+    compact_starts_[i] = compact_implications_.size();
+    compact_implications_.insert(compact_implications_.end(),
+                                 implications_[i].begin(),
+                                 implications_[i].end());
+  }
+  compact_starts_[LiteralIndex(num_literals)] = compact_implications_.size();
+  num_implications_at_last_rebuild_ = num_implications_;
+  compact_implications_are_valid_ = true;
+}
+
 absl::Span<const Literal> BinaryImplicationGraph::Reason(
     const Trail& trail, int trail_index) const {
   return {&reasons_[trail_index], 1};
@@ -868,6 +917,7 @@ void BinaryImplicationGraph::MinimizeConflictWithReachability(
     if (new_size < direct_implications.size()) {
       num_redundant_implications_ += direct_implications.size() - new_size;
       direct_implications.resize(new_size);
+      compact_implications_are_valid_ = false;
     }
   }
 
@@ -911,6 +961,10 @@ void BinaryImplicationGraph::MinimizeConflictFirstWithTransitiveReduction(
   // a => b and remove b, a must be before b in direct_implications. Note that
   // a std::reverse() could work too. But randomization seems to work better.
   // Probably because it has other impact on the search tree.
+  //
+  // Note that this reorders the list of the root, so its compact copy must be
+  // rebuilt.
+  compact_implications_are_valid_ = false;
   std::shuffle(direct_implications.begin(), direct_implications.end(), random);
   dfs_stack_.clear();
   for (const Literal l : direct_implications) {
@@ -1019,6 +1073,7 @@ void BinaryImplicationGraph::RemoveFixedVariables() {
   DCHECK_EQ(propagation_trail_index_, new_num_fixed);
   if (num_processed_fixed_variables_ == new_num_fixed) return;
 
+  compact_implications_are_valid_ = false;
   const VariablesAssignment& assignment = trail_->Assignment();
   is_marked_.ClearAndResize(LiteralIndex(implications_.size()));
   for (; num_processed_fixed_variables_ < new_num_fixed;
@@ -1184,6 +1239,7 @@ bool BinaryImplicationGraph::DetectEquivalences(bool log_info) {
   // Lets remove all fixed variables first.
   if (!Propagate(trail_)) return false;
   RemoveFixedVariables();
+  compact_implications_are_valid_ = false;
   const VariablesAssignment& assignment = trail_->Assignment();
 
   // TODO(user): We could just do it directly though.
@@ -1369,6 +1425,7 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
   // with any of that here.
   if (!Propagate(trail_)) return false;
   RemoveFixedVariables();
+  compact_implications_are_valid_ = false;
 
   log_info |= VLOG_IS_ON(1);
   WallTimer wall_timer;
@@ -2036,6 +2093,7 @@ int64_t BinaryImplicationGraph::NumImplicationOnVariableRemoval(
 // For all possible a => var => b, add a => b.
 void BinaryImplicationGraph::RemoveBooleanVariable(
     BooleanVariable var, std::deque<std::vector<Literal>>* postsolve_clauses) {
+  compact_implications_are_valid_ = false;
   const Literal literal(var, true);
   direct_implications_of_negated_literal_ =
       DirectImplications(literal.Negated());
@@ -2078,6 +2136,7 @@ void BinaryImplicationGraph::RemoveBooleanVariable(
 }
 
 void BinaryImplicationGraph::CleanupAllRemovedVariables() {
+  compact_implications_are_valid_ = false;
   for (auto& implication : implications_) {
     int new_size = 0;
     for (const Literal l : implication) {
@@ -461,7 +461,9 @@ class BinaryImplicationGraph : public SatPropagator {
         stats_("BinaryImplicationGraph"),
         time_limit_(model->GetOrCreate<TimeLimit>()),
         random_(model->GetOrCreate<ModelRandomGenerator>()),
-        trail_(model->GetOrCreate<Trail>()) {
+        trail_(model->GetOrCreate<Trail>()),
+        use_compact_implications_(model->GetOrCreate<SatParameters>()
+                                      ->use_compact_binary_implications()) {
     trail_->RegisterPropagator(this);
   }
 
@@ -741,6 +743,11 @@ class BinaryImplicationGraph : public SatPropagator {
   // This calls trail->Enqueue() on the newly assigned literals.
   bool PropagateOnTrue(Literal true_literal, Trail* trail);
 
+  // Copies all the implications_ lists into compact_implications_. This must
+  // be called again after any change to implications_ other than appending
+  // new implications, see compact_implications_are_valid_.
+  void RebuildCompactImplications();
+
   // Remove any literal whose negation is marked (except the first one).
   void RemoveRedundantLiterals(std::vector<Literal>* conflict);
 
@@ -786,6 +793,23 @@ class BinaryImplicationGraph : public SatPropagator {
       implications_;
   int64_t num_implications_ = 0;
 
+  // A copy of all the implications_ lists in one contiguous array, the list of
+  // a literal l being compact_implications_[compact_starts_[l],
+  // compact_starts_[l + 1]). This is faster to scan during propagation than
+  // the lists themselves when they are not inlined. The implications added
+  // after the last RebuildCompactImplications() are appended at the end of
+  // the implications_ lists, so they are still read from there. Any other
+  // change to implications_ must clear compact_implications_are_valid_ before
+  // it is done. Most of them happen at level zero, but the conflict
+  // minimizations that prune the list of the conflict literal reorder or
+  // shrink it at any level. The copy is then rebuilt lazily by the next
+  // Propagate() at a positive decision level.
+  const bool use_compact_implications_;
+  bool compact_implications_are_valid_ = false;
+  int64_t num_implications_at_last_rebuild_ = 0;
+  std::vector<Literal> compact_implications_;
+  absl::StrongVector<LiteralIndex, int> compact_starts_;
+
   // Internal representation of at_most_one constraints. Each entry point to the
   // start of a constraint in the buffer. Constraints are terminated by
   // kNoLiteral. When LiteralIndex is true, then all entry in the at most one
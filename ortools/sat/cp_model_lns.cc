@@ -1411,6 +1411,121 @@ Neighborhood RelaxObjectiveVariablesGenerator::Generate(
       initial_solution, {fixed_variables.begin(), fixed_variables.end()});
 }
 
+bool SolutionCrossoverNeighborhoodGenerator::ReadyToGenerate() const {
+  return helper_.shared_response().SolutionsRepository().NumSolutions() > 1;
+}
+
+Neighborhood SolutionCrossoverNeighborhoodGenerator::Generate(
+    const CpSolverResponse& initial_solution, double difficulty,
+    absl::BitGenRef random) {
+  // Select one or two other solutions of the pool that differ from the base
+  // one. Note that we do not use GetRandomBiasedSolution() here so that we do
+  // not change the selection statistics of the pool.
+  const SharedSolutionRepository<int64_t>& repo =
+      helper_.shared_response().SolutionsRepository();
+  std::vector<int> indices(repo.NumSolutions());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::shuffle(indices.begin(), indices.end(), random);
+  const int max_num_others = absl::Uniform<int>(random, 1, 3);
+  std::vector<std::vector<int64_t>> others;
+  for (const int index : indices) {
+    std::vector<int64_t> values = repo.GetSolution(index).variable_values;
+    if (values.size() != initial_solution.solution_size()) continue;
+    if (std::equal(values.begin(), values.end(),
+                   initial_solution.solution().begin())) {
+      continue;
+    }
+    others.push_back(std::move(values));
+    if (others.size() == max_num_others) break;
+  }
+  if (others.empty()) return helper_.NoNeighborhood();
+
+  // Split the active variables depending on whether all the parents agree.
+  std::vector<int> relaxed_variables;
+  std::vector<int> agreeing_variables;
+  const std::vector<int> active_variables = helper_.ActiveVariables();
+  for (const int var : active_variables) {
+    const int64_t value = initial_solution.solution(var);
+    bool agree = true;
+    for (const std::vector<int64_t>& other : others) {
+      if (other[var] != value) {
+        agree = false;
+        break;
+      }
+    }
+    if (agree) {
+      agreeing_variables.push_back(var);
+    } else {
+      relaxed_variables.push_back(var);
+    }
+  }
+
+  const int target_size = std::ceil(difficulty * active_variables.size());
+  if (relaxed_variables.size() > target_size) {
+    std::shuffle(relaxed_variables.begin(), relaxed_variables.end(), random);
+    relaxed_variables.resize(target_size);
+  } else {
+    std::shuffle(agreeing_variables.begin(), agreeing_variables.end(), random);
+    const int num_to_add = target_size - relaxed_variables.size();
+    relaxed_variables.insert(relaxed_variables.end(),
+                             agreeing_variables.begin(),
+                             agreeing_variables.begin() + num_to_add);
+  }
+
+  Neighborhood neighborhood =
+      helper_.RelaxGivenVariables(initial_solution, relaxed_variables);
+  neighborhood.source_info = absl::StrCat(others.size() + 1, "_parents");
+  return neighborhood;
+}
+
+Neighborhood LocalBranchingNeighborhoodGenerator::Generate(
+    const CpSolverResponse& initial_solution, double difficulty,
+    absl::BitGenRef random) {
+  std::vector<int> booleans;
+  std::vector<int> fixed_variables;
+  for (const int var : helper_.ActiveVariables()) {
+    const IntegerVariableProto& var_proto = helper_.ModelProto().variables(var);
+    if (var_proto.domain_size() == 2 && var_proto.domain(0) == 0 &&
+        var_proto.domain(1) == 1) {
+      booleans.push_back(var);
+    } else {
+      fixed_variables.push_back(var);
+    }
+  }
+  if (booleans.empty()) return helper_.NoNeighborhood();
+
+  GetRandomSubset(1.0 - difficulty, &fixed_variables, random);
+  Neighborhood neighborhood = helper_.FixGivenVariables(
+      initial_solution, {fixed_variables.begin(), fixed_variables.end()});
+
+  // Restrict the number of Booleans that can change their value:
+  //   Sum_{x* = 0} x + Sum_{x* = 1} (1 - x) <= radius.
+  const int radius = std::max<int>(1, std::round(difficulty * booleans.size()));
+  if (radius < booleans.size()) {
+    LinearConstraintProto* linear =
+        neighborhood.delta.add_constraints()->mutable_linear();
+    int64_t num_ones = 0;
+    for (const int var : booleans) {
+      linear->add_vars(var);
+      if (initial_solution.solution(var) == 0) {
+        linear->add_coeffs(1);
+      } else {
+        linear->add_coeffs(-1);
+        ++num_ones;
+      }
+    }
+    linear->add_domain(std::numeric_limits<int64_t>::min());
+    linear->add_domain(radius - num_ones);
+    neighborhood.is_reduced = true;
+
+    // The constraint links all the relaxed components together, and it is no
+    // longer a neighborhood defined by fixed variables only.
+    neighborhood.is_simple = false;
+    neighborhood.variables_that_can_be_fixed_to_local_optimum.clear();
+  }
+  return neighborhood;
+}
+
 namespace {
 
 void AddPrecedence(const LinearExpressionProto& before,
@@ -524,6 +524,37 @@ class RelaxObjectiveVariablesGenerator : public NeighborhoodGenerator {
                         double difficulty, absl::BitGenRef random) final;
 };
 
+// Crossover between the base solution and one or two other solutions of the
+// solution pool: the active variables on which all these solutions agree are
+// fixed, and the others are relaxed. To respect the difficulty, we only relax
+// a random subset of them if there are too many, or we also relax some random
+// agreeing variables if there are not enough.
+class SolutionCrossoverNeighborhoodGenerator : public NeighborhoodGenerator {
+ public:
+  explicit SolutionCrossoverNeighborhoodGenerator(
+      NeighborhoodGeneratorHelper const* helper, const std::string& name)
+      : NeighborhoodGenerator(name, helper) {}
+  Neighborhood Generate(const CpSolverResponse& initial_solution,
+                        double difficulty, absl::BitGenRef random) final;
+
+  // Returns true if the pool contains at least two solutions.
+  bool ReadyToGenerate() const override;
+};
+
+// Local branching neighborhood: the Boolean variables are restricted to a
+// Hamming ball around the base solution whose radius depends on the
+// difficulty, and a random subset of the other variables is fixed like in
+// RelaxRandomVariablesGenerator. See "Local branching", Matteo Fischetti and
+// Andrea Lodi, Mathematical Programming 98, 2003.
+class LocalBranchingNeighborhoodGenerator : public NeighborhoodGenerator {
+ public:
+  explicit LocalBranchingNeighborhoodGenerator(
+      NeighborhoodGeneratorHelper const* helper, const std::string& name)
+      : NeighborhoodGenerator(name, helper) {}
+  Neighborhood Generate(const CpSolverResponse& initial_solution,
+                        double difficulty, absl::BitGenRef random) final;
+};
+
 // Helper method for the scheduling neighborhood generators. Returns a
 // neighborhood defined from the given set of intervals to relax. For each
 // scheduling constraint, it adds strict relation order between the non-relaxed
@@ -20,6 +20,7 @@
 #include <deque>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <tuple>
@@ -39,6 +40,7 @@
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/timer.h"
 #include "ortools/graph/topologicalsorter.h"
 #include "ortools/sat/circuit.h"
@@ -6286,6 +6288,45 @@ void CpModelPresolver::Probe() {
   auto* mapping = model.GetOrCreate<CpModelMapping>();
   auto* prober = model.GetOrCreate<Prober>();
 
+  // If we use extra probing threads, the Boolean variables that
+  // ProbeBooleanVariables() would probe are split in contiguous ranges between
+  // this thread and them, so that the literals encoding the same integer
+  // variable are probed by the same thread. Each extra thread probes its range
+  // on its own copy of the model. Note that these copies must be loaded before
+  // the callback below starts to modify the working model. Since they are
+  // loaded from the same context, their Boolean variables are the same as
+  // ours.
+  const int num_extra_threads =
+      context_->params().num_presolve_probing_threads();
+  const int num_variables = context_->working_model->variables().size();
+  const int num_loaded_bool_vars = sat_solver->NumVariables();
+  std::vector<std::unique_ptr<Model>> thread_models;
+  std::vector<std::vector<BooleanVariable>> vars_to_probe(num_extra_threads +
+                                                          1);
+  if (num_extra_threads > 0) {
+    std::vector<BooleanVariable> bool_vars;
+    for (BooleanVariable b(0); b < num_loaded_bool_vars; ++b) {
+      if (sat_solver->Assignment().VariableIsAssigned(b)) continue;
+      const Literal literal(b, true);
+      if (implication_graph->RepresentativeOf(literal) != literal) continue;
+      bool_vars.push_back(b);
+    }
+    const int num_parts = num_extra_threads + 1;
+    for (int i = 0; i < bool_vars.size(); ++i) {
+      vars_to_probe[static_cast<int64_t>(i) * num_parts / bool_vars.size()]
+          .push_back(bool_vars[i]);
+    }
+    for (int t = 0; t < num_extra_threads; ++t) {
+      thread_models.push_back(std::make_unique<Model>());
+      Model* thread_model = thread_models.back().get();
+      thread_model->GetOrCreate<SolverLogger>();
+      thread_model->GetOrCreate<ModelRandomGenerator>();
+      if (!LoadModelForProbing(context_, thread_model)) return;
+      DCHECK_EQ(thread_model->GetOrCreate<SatSolver>()->NumVariables(),
+                num_loaded_bool_vars);
+    }
+  }
+
   // Try to detect trivial clauses thanks to implications.
   // This can be slow, so we bound the amount of work done.
   //
@@ -6438,8 +6479,29 @@ void CpModelPresolver::Probe() {
     });
   }
 
-  prober->ProbeBooleanVariables(
-      context_->params().probing_deterministic_time_limit());
+  const double probing_time_limit =
+      context_->params().probing_deterministic_time_limit();
+  std::vector<std::vector<std::pair<Literal, Literal>>> thread_binary_clauses(
+      num_extra_threads);
+  if (num_extra_threads == 0) {
+    prober->ProbeBooleanVariables(probing_time_limit);
+  } else {
+    ThreadPool pool("PresolveProbing", num_extra_threads);
+    pool.StartWorkers();
+    for (int t = 0; t < num_extra_threads; ++t) {
+      pool.Schedule([&, t]() {
+        Model* thread_model = thread_models[t].get();
+        auto* thread_prober = thread_model->GetOrCreate<Prober>();
+        thread_prober->SetNewBinaryClauseCallback(
+            [clauses = &thread_binary_clauses[t]](Literal a, Literal b) {
+              clauses->push_back({a, b});
+            });
+        thread_prober->ProbeBooleanVariables(probing_time_limit,
+                                             vars_to_probe[t + 1]);
+      });
+    }
+    prober->ProbeBooleanVariables(probing_time_limit, vars_to_probe[0]);
+  }
   context_->time_limit()->AdvanceDeterministicTime(
       model.GetOrCreate<TimeLimit>()->GetElapsedDeterministicTime());
   if (work_done > 0) {
@@ -6447,6 +6509,63 @@ void CpModelPresolver::Probe() {
                "[Probing] implications and bool_or (work_done=", work_done,
                ").", (work_done > work_limit ? " Aborted." : ""));
   }
+
+  // Merge what the extra threads found, in a deterministic order. The fixed
+  // literals and binary clauses are added to our model so that they are used
+  // below, and the domains are directly intersected in the context.
+  if (num_extra_threads > 0) {
+    int64_t num_merged_fixed = 0;
+    int64_t num_merged_binary = 0;
+    for (int t = 0; t < num_extra_threads; ++t) {
+      Model* thread_model = thread_models[t].get();
+      auto* thread_sat_solver = thread_model->GetOrCreate<SatSolver>();
+      if (thread_sat_solver->ModelIsUnsat()) {
+        return (void)context_->NotifyThatModelIsUnsat(
+            "during parallel probing");
+      }
+      // The literals created by the thread while probing are not in our model.
+      const auto to_literal_index = [num_loaded_bool_vars](Literal l) {
+        return l.Variable() < num_loaded_bool_vars ? l.Index()
+                                                   : kNoLiteralIndex;
+      };
+      for (int i = 0; i < thread_sat_solver->LiteralTrail().Index(); ++i) {
+        const LiteralIndex index =
+            to_literal_index(thread_sat_solver->LiteralTrail()[i]);
+        if (index == kNoLiteralIndex) continue;
+        ++num_merged_fixed;
+        if (!sat_solver->AddUnitClause(Literal(index))) break;
+      }
+      for (const auto& [a, b] : thread_binary_clauses[t]) {
+        const LiteralIndex index_a = to_literal_index(a);
+        const LiteralIndex index_b = to_literal_index(b);
+        if (index_a == kNoLiteralIndex || index_b == kNoLiteralIndex) continue;
+        ++num_merged_binary;
+        if (!sat_solver->AddBinaryClause(Literal(index_a), Literal(index_b))) {
+          break;
+        }
+      }
+      if (sat_solver->ModelIsUnsat()) break;
+
+      auto* thread_mapping = thread_model->GetOrCreate<CpModelMapping>();
+      auto* thread_integer_trail = thread_model->GetOrCreate<IntegerTrail>();
+      for (int var = 0; var < num_variables; ++var) {
+        if (thread_mapping->IsBoolean(var)) continue;
+        const IntegerVariable i_var = thread_mapping->Integer(var);
+        const Domain bounds(
+            thread_integer_trail->LevelZeroLowerBound(i_var).value(),
+            thread_integer_trail->LevelZeroUpperBound(i_var).value());
+        if (!context_->IntersectDomainWith(
+                var, thread_integer_trail->InitialVariableDomain(i_var)
+                         .IntersectionWith(bounds))) {
+          return;
+        }
+      }
+    }
+    SOLVER_LOG(logger_, "[Probing] merged from ", num_extra_threads,
+               " extra threads: ", num_merged_fixed, " fixed literals, ",
+               num_merged_binary, " binary clauses.");
+  }
+
   if (sat_solver->ModelIsUnsat() || !implication_graph->DetectEquivalences()) {
     return (void)context_->NotifyThatModelIsUnsat("during probing");
   }
@@ -6462,7 +6581,6 @@ void CpModelPresolver::Probe() {
     }
   }
 
-  const int num_variables = context_->working_model->variables().size();
   auto* integer_trail = model.GetOrCreate<IntegerTrail>();
   for (int var = 0; var < num_variables; ++var) {
     // Restrict IntegerVariable domain.
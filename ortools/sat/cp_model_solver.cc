@@ -14,6 +14,7 @@
 #include "ortools/sat/cp_model_solver.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
@@ -47,6 +48,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "ortools/base/cleanup.h"
 #include "ortools/graph/connected_components.h"
@@ -93,6 +95,7 @@
 #include "ortools/sat/util.h"
 #include "ortools/util/logging.h"
 #include "ortools/util/random_engine.h"
+#include "ortools/util/saturated_arithmetic.h"
 #if !defined(__PORTABLE_PLATFORM__)
 #include "ortools/util/sigint.h"
 #endif  // __PORTABLE_PLATFORM__
@@ -1354,6 +1357,58 @@ int RegisterClausesLevelZeroImport(int id,
   return id;
 }
 
+// Registers callbacks on each LP of the model to export the cuts they find at
+// level zero to the shared_cuts_manager, and to import the cuts found by the
+// other workers. Cuts involving variables without a proto counterpart (like the
+// ones created by the linearization) are not exported.
+void RegisterCutsSharing(SharedCutsManager* shared_cuts_manager, Model* model) {
+  CHECK(shared_cuts_manager != nullptr);
+  CpModelMapping* const mapping = model->GetOrCreate<CpModelMapping>();
+  for (LinearProgrammingConstraint* lp :
+       *model->GetOrCreate<LinearProgrammingConstraintCollection>()) {
+    const int id = shared_cuts_manager->RegisterNewId();
+    shared_cuts_manager->SetWorkerNameForId(id, model->Name());
+    const auto export_cut = [mapping, id,
+                             shared_cuts_manager](const LinearConstraint& cut) {
+      LinearConstraintProto proto;
+      for (int i = 0; i < cut.vars.size(); ++i) {
+        const IntegerVariable var = cut.vars[i];
+        const int proto_var =
+            mapping->GetProtoVariableFromIntegerVariable(PositiveVariable(var));
+        if (proto_var == -1) return;
+        proto.add_vars(proto_var);
+        proto.add_coeffs(VariableIsPositive(var) ? cut.coeffs[i].value()
+                                                 : -cut.coeffs[i].value());
+      }
+      proto.add_domain(cut.lb.value());
+      proto.add_domain(cut.ub.value());
+      shared_cuts_manager->AddCut(id, std::move(proto));
+    };
+    const auto import_cuts = [mapping, id, shared_cuts_manager](
+                                 std::vector<LinearConstraint>* cuts) {
+      std::vector<LinearConstraintProto> new_cuts;
+      shared_cuts_manager->GetUnseenCuts(id, &new_cuts);
+      for (const LinearConstraintProto& proto : new_cuts) {
+        LinearConstraint cut;
+        bool all_vars_mapped = true;
+        for (int i = 0; i < proto.vars_size(); ++i) {
+          if (!mapping->IsInteger(proto.vars(i))) {
+            all_vars_mapped = false;
+            break;
+          }
+          cut.vars.push_back(mapping->Integer(proto.vars(i)));
+          cut.coeffs.push_back(IntegerValue(proto.coeffs(i)));
+        }
+        if (!all_vars_mapped) continue;
+        cut.lb = IntegerValue(proto.domain(0));
+        cut.ub = IntegerValue(proto.domain(1));
+        cuts->push_back(std::move(cut));
+      }
+    };
+    lp->SetCutsSharingCallbacks(export_cut, import_cuts);
+  }
+}
+
 void LoadBaseModel(const CpModelProto& model_proto, Model* model) {
   auto* shared_response_manager = model->GetOrCreate<SharedResponseManager>();
   CHECK(shared_response_manager != nullptr);
@@ -2336,6 +2391,8 @@ CpSolverResponse SolvePureSatModel(const CpModelProto& model_proto,
 
 #if !defined(__PORTABLE_PLATFORM__)
 
+class PersistentLnsModels;
+
 // Small wrapper to simplify the constructions of the two SubSolver below.
 struct SharedClasses {
   CpModelProto const* model_proto;
@@ -2347,6 +2404,10 @@ struct SharedClasses {
   SharedLPSolutionRepository* lp_solutions;
   SharedIncompleteSolutionManager* incomplete_solutions;
   SharedClausesManager* clauses;
+  SharedCutsManager* cuts;
+  SharedLbTreeManager* lb_tree;
+  PersistentLnsModels* lns_models;
+  CutGeneratorThreadPool* cut_generator_pool;
   Model* global_model;
 
   bool SearchIsDone() {
@@ -2403,6 +2464,16 @@ class FullProblemSolver : public SubSolver {
       local_model_->Register<SharedClausesManager>(shared->clauses);
     }
 
+    if (shared->lb_tree != nullptr &&
+        local_parameters.optimize_with_lb_tree_search()) {
+      local_model_->Register<SharedLbTreeManager>(shared->lb_tree);
+    }
+
+    if (shared->cut_generator_pool != nullptr) {
+      local_model_->Register<CutGeneratorThreadPool>(
+          shared->cut_generator_pool);
+    }
+
     // TODO(user): For now we do not count LNS statistics. We could easily
     // by registering the SharedStatistics class with LNS local model.
     local_model_->Register<SharedStatistics>(
@@ -2459,6 +2530,10 @@ class FullProblemSolver : public SubSolver {
           RegisterClausesExport(id, shared_->clauses, local_model_.get());
         }
 
+        if (shared_->cuts != nullptr) {
+          RegisterCutsSharing(shared_->cuts, local_model_.get());
+        }
+
         if (local_model_->GetOrCreate<SatParameters>()->repair_hint()) {
           MinimizeL1DistanceWithHint(*shared_->model_proto, local_model_.get());
         } else {
@@ -2702,6 +2777,111 @@ class FeasibilityPumpSolver : public SubSolver {
   bool previous_task_is_completed_ ABSL_GUARDED_BY(mutex_) = true;
 };
 
+// A pool of models in which the full model is loaded once, so that the LNS
+// workers can solve the neighborhoods that only restrict the variable domains
+// without copying, presolving and loading a fragment of the model. The models
+// are loaded with the parameters of the LNS solver using them, and each model
+// is used by one task at a time, so there are at most as many models per set
+// of parameters as threads.
+class PersistentLnsModels {
+ public:
+  // A loaded model, with its number of Boolean variables right after loading.
+  struct LoadedModel {
+    std::unique_ptr<Model> model;
+    int num_loaded_variables = 0;
+  };
+
+  PersistentLnsModels(const CpModelProto& model_proto,
+                      ModelSharedTimeLimit* time_limit,
+                      SharedBoundsManager* bounds,
+                      CutGeneratorThreadPool* cut_generator_pool)
+      : model_proto_(model_proto),
+        time_limit_(time_limit),
+        bounds_(bounds),
+        cut_generator_pool_(cut_generator_pool) {}
+
+  // Returns the parameters of the models used to solve the neighborhoods with
+  // the given local parameters.
+  static SatParameters ModelParameters(const SatParameters& local_params) {
+    SatParameters parameters = local_params;
+    // The time limit is reset for each neighborhood.
+    parameters.clear_max_deterministic_time();
+    parameters.set_log_search_progress(false);
+    parameters.set_cp_model_probing_level(0);
+    parameters.set_symmetry_level(0);
+    // The objective variable must be linked to the objective terms, and the
+    // search must be a plain search under assumptions.
+    parameters.set_optimize_with_core(false);
+    parameters.set_optimize_with_lb_tree_search(false);
+    parameters.set_use_probing_search(false);
+    return parameters;
+  }
+
+  // Returns a model loaded with the given parameters that is not used by any
+  // other task. The model is null if it is infeasible.
+  LoadedModel Acquire(const SatParameters& parameters) {
+    const std::string key = parameters.SerializeAsString();
+    std::string name;
+    {
+      absl::MutexLock mutex_lock(&mutex_);
+      std::vector<LoadedModel>& models = models_[key];
+      if (!models.empty()) {
+        LoadedModel loaded_model = std::move(models.back());
+        models.pop_back();
+        return loaded_model;
+      }
+      name = absl::StrCat("persistent_lns_", num_created_models_++);
+    }
+
+    // Loading a big model takes time, so we do it outside of the mutex.
+    LoadedModel loaded_model;
+    loaded_model.model = std::make_unique<Model>(name);
+    Model* model = loaded_model.model.get();
+    *model->GetOrCreate<SatParameters>() = parameters;
+    time_limit_->UpdateLocalLimit(model->GetOrCreate<TimeLimit>());
+    if (cut_generator_pool_ != nullptr) {
+      model->Register<CutGeneratorThreadPool>(cut_generator_pool_);
+    }
+    auto* response_manager = model->GetOrCreate<SharedResponseManager>();
+    response_manager->InitializeObjective(model_proto_);
+    response_manager->SetSynchronizationMode(true);
+    LoadCpModel(model_proto_, model);
+    if (bounds_ != nullptr) {
+      RegisterVariableBoundsLevelZeroImport(model_proto_, bounds_, model);
+    }
+    auto* sat_solver = model->GetOrCreate<SatSolver>();
+    if (sat_solver->ModelIsUnsat()) return LoadedModel();
+    ConfigureSearchHeuristics(model);
+    loaded_model.num_loaded_variables = sat_solver->NumVariables();
+    return loaded_model;
+  }
+
+  // Gives back a model returned by Acquire() with the same parameters. Each
+  // neighborhood can create new literals for its bounds, so a model is dropped
+  // once its number of Boolean variables doubled since loading; a new one is
+  // loaded on demand.
+  void Release(const SatParameters& parameters, LoadedModel loaded_model) {
+    if (loaded_model.model->GetOrCreate<SatSolver>()->NumVariables() >
+        2 * loaded_model.num_loaded_variables) {
+      return;
+    }
+    absl::MutexLock mutex_lock(&mutex_);
+    models_[parameters.SerializeAsString()].push_back(std::move(loaded_model));
+  }
+
+ private:
+  const CpModelProto& model_proto_;
+  ModelSharedTimeLimit* time_limit_;
+  SharedBoundsManager* bounds_;
+  CutGeneratorThreadPool* cut_generator_pool_;
+
+  absl::Mutex mutex_;
+  // The models, by serialized parameters.
+  absl::btree_map<std::string, std::vector<LoadedModel>> models_
+      ABSL_GUARDED_BY(mutex_);
+  int num_created_models_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
 // A Subsolver that generate LNS solve from a given neighborhood.
 class LnsSolver : public SubSolver {
  public:
@@ -2793,122 +2973,27 @@ class LnsSolver : public SubSolver {
       local_params.set_find_big_linear_overlap(false);
       local_params.set_solution_pool_size(1);  // Keep the best solution found.
 
-      Model local_model(lns_info);
-      *(local_model.GetOrCreate<SatParameters>()) = local_params;
-      TimeLimit* local_time_limit = local_model.GetOrCreate<TimeLimit>();
-      local_time_limit->ResetLimitFromParameters(local_params);
-      shared_->time_limit->UpdateLocalLimit(local_time_limit);
-
-      // Presolve and solve the LNS fragment.
-      CpModelProto lns_fragment;
-      CpModelProto mapping_proto;
-      auto context = std::make_unique<PresolveContext>(
-          &local_model, &lns_fragment, &mapping_proto);
-
-      *lns_fragment.mutable_variables() = neighborhood.delta.variables();
-      {
-        ModelCopy copier(context.get());
-
-        // Copy and simplify the constraints from the initial model.
-        if (!copier.ImportAndSimplifyConstraints(
-                helper_->ModelProto(), neighborhood.constraints_to_ignore)) {
-          return;
-        }
-
-        // Copy and simplify the constraints from the delta model.
-        if (!neighborhood.delta.constraints().empty() &&
-            !copier.ImportAndSimplifyConstraints(neighborhood.delta, {})) {
-          return;
-        }
-      }
-
-      // Copy the rest of the model and overwrite the name.
-      CopyEverythingExceptVariablesAndConstraintsFieldsIntoContext(
-          helper_->ModelProto(), context.get());
-      lns_fragment.set_name(absl::StrCat("lns_", task_id));
-
-      // Overwrite solution hinting.
-      if (neighborhood.delta.has_solution_hint()) {
-        *lns_fragment.mutable_solution_hint() =
-            neighborhood.delta.solution_hint();
-      }
-
-      CpModelProto debug_copy;
-      if (absl::GetFlag(FLAGS_cp_model_dump_problematic_lns)) {
-        // We need to make a copy because the presolve is destructive.
-        // It is why we do not do that by default.
-        debug_copy = lns_fragment;
-      }
-
-#if !defined(__PORTABLE_PLATFORM__)
-#endif  // __PORTABLE_PLATFORM__
-
-      if (absl::GetFlag(FLAGS_cp_model_dump_lns)) {
-        // TODO(user): export the delta too if needed.
-        const std::string lns_name =
-            absl::StrCat(absl::GetFlag(FLAGS_cp_model_dump_prefix),
-                         lns_fragment.name(), ".pb.txt");
-        LOG(INFO) << "Dumping LNS model to '" << lns_name << "'.";
-        CHECK(WriteModelProtoToFile(lns_fragment, lns_name));
-      }
-
-      std::vector<int> postsolve_mapping;
-      const CpSolverStatus presolve_status =
-          PresolveCpModel(context.get(), &postsolve_mapping);
-
-      // Release the context.
-      context.reset(nullptr);
-      neighborhood.delta.Clear();
-
-      // TODO(user): Depending on the problem, we should probably use the
-      // parameters that work bests (core, linearization_level, etc...) or
-      // maybe we can just randomize them like for the base solution used.
-      auto* local_response_manager =
-          local_model.GetOrCreate<SharedResponseManager>();
-      local_response_manager->InitializeObjective(lns_fragment);
-      local_response_manager->SetSynchronizationMode(true);
-
       CpSolverResponse local_response;
-      if (presolve_status == CpSolverStatus::UNKNOWN) {
-        LoadCpModel(lns_fragment, &local_model);
-        QuickSolveWithHint(lns_fragment, &local_model);
-        SolveLoadedCpModel(lns_fragment, &local_model);
-        local_response = local_response_manager->GetResponse();
-        // In case the LNS model is empty after presolve, the solution
-        // repository does not add the solution, and thus does not store the
-        // solution info. In that case, we put it back.
-        if (local_response.solution_info().empty()) {
-          local_response.set_solution_info(
-              absl::StrCat(lns_info, " [presolve]"));
-        }
-      } else {
-        // TODO(user): Clean this up? when the model is closed by presolve,
-        // we don't have a nice api to get the response with stats. That said
-        // for LNS, we don't really need it.
-        if (presolve_status == CpSolverStatus::INFEASIBLE) {
-          local_response_manager->NotifyThatImprovingProblemIsInfeasible(
-              "presolve");
-        }
-        local_response = local_response_manager->GetResponse();
-        local_response.set_status(presolve_status);
+      CpModelProto debug_copy;
+      const bool solved_with_persistent_model =
+          shared_->lns_models != nullptr && neighborhood.is_simple &&
+          neighborhood.constraints_to_ignore.empty() &&
+          neighborhood.delta.constraints().empty() &&
+          base_response.status() == CpSolverStatus::FEASIBLE &&
+          SolveWithPersistentModel(task_id, neighborhood, base_response,
+                                   data.base_objective, lns_info, local_params,
+                                   &debug_copy, &local_response,
+                                   &data.deterministic_time);
+      if (!solved_with_persistent_model &&
+          !SolveFragment(task_id, lns_info, local_params, &neighborhood,
+                         &debug_copy, &local_response,
+                         &data.deterministic_time)) {
+        return;
       }
       const std::string solution_info = local_response.solution_info();
-      std::vector<int64_t> solution_values(local_response.solution().begin(),
-                                           local_response.solution().end());
-
+      const std::vector<int64_t> solution_values(
+          local_response.solution().begin(), local_response.solution().end());
       data.status = local_response.status();
-      // TODO(user): we actually do not need to postsolve if the solution is
-      // not going to be used...
-      if (data.status == CpSolverStatus::OPTIMAL ||
-          data.status == CpSolverStatus::FEASIBLE) {
-        PostsolveResponseWrapper(
-            local_params, helper_->ModelProto().variables_size(), mapping_proto,
-            postsolve_mapping, &solution_values);
-        local_response.mutable_solution()->Assign(solution_values.begin(),
-                                                  solution_values.end());
-      }
-
-      data.deterministic_time = local_time_limit->GetElapsedDeterministicTime();
 
       bool new_solution = false;
       bool display_lns_info = VLOG_IS_ON(2);
@@ -3036,6 +3121,260 @@ class LnsSolver : public SubSolver {
   // TODO(user): Display LNS success rate.
 
  private:
+  // Solves a neighborhood that only restricts the variable domains on a model
+  // of shared_->lns_models, by assuming the new variable bounds. As for a
+  // fragment, the search looks for solutions strictly better than the base
+  // one, and the base solution is returned as optimal if there is none.
+  // Returns false, without solving anything, if the neighborhood cannot be
+  // expressed with bounds because a domain has holes that the model does not
+  // have.
+  bool SolveWithPersistentModel(int64_t task_id,
+                                const Neighborhood& neighborhood,
+                                const CpSolverResponse& base_response,
+                                IntegerValue base_objective,
+                                const std::string& lns_info,
+                                const SatParameters& local_params,
+                                CpModelProto* debug_copy,
+                                CpSolverResponse* response,
+                                double* deterministic_time) {
+    const SatParameters model_params =
+        PersistentLnsModels::ModelParameters(local_params);
+    PersistentLnsModels::LoadedModel loaded_model =
+        shared_->lns_models->Acquire(model_params);
+    Model* model = loaded_model.model.get();
+    if (model == nullptr) return false;
+
+    const CpModelProto& model_proto = *shared_->model_proto;
+    const CpModelMapping& mapping = *model->GetOrCreate<CpModelMapping>();
+    auto* sat_solver = model->GetOrCreate<SatSolver>();
+    auto* integer_trail = model->GetOrCreate<IntegerTrail>();
+    auto* encoder = model->GetOrCreate<IntegerEncoder>();
+
+    // The new domains are only enforced through their bounds, so their holes
+    // must already be holes of the loaded domains.
+    const int num_variables = neighborhood.delta.variables_size();
+    for (int i = 0; i < num_variables; ++i) {
+      if (!mapping.IsInteger(i)) continue;
+      const Domain domain =
+          ReadDomainFromProto(neighborhood.delta.variables(i));
+      if (domain.IsEmpty() ||
+          !integer_trail->InitialVariableDomain(mapping.Integer(i))
+               .IntersectionWith(Domain(domain.Min(), domain.Max()))
+               .IsIncludedIn(domain)) {
+        shared_->lns_models->Release(model_params, std::move(loaded_model));
+        return false;
+      }
+    }
+
+    response->set_status(CpSolverStatus::UNKNOWN);
+    response->set_solution_info(absl::StrCat(lns_info, " [persistent]"));
+    if (absl::GetFlag(FLAGS_cp_model_dump_problematic_lns)) {
+      *debug_copy = model_proto;
+      *debug_copy->mutable_variables() = neighborhood.delta.variables();
+      debug_copy->set_name(absl::StrCat("lns_", task_id));
+    }
+
+    TimeLimit* time_limit = model->GetOrCreate<TimeLimit>();
+    time_limit->ResetLimitFromParameters(local_params);
+    shared_->time_limit->UpdateLocalLimit(time_limit);
+
+    // The assumption literals are created at level zero.
+    bool model_is_feasible = sat_solver->ResetToLevelZero();
+    std::vector<Literal> assumptions;
+    for (int i = 0; model_is_feasible && i < num_variables; ++i) {
+      const Domain domain =
+          ReadDomainFromProto(neighborhood.delta.variables(i));
+      if (mapping.IsBoolean(i)) {
+        if (!domain.IsFixed()) continue;
+        const Literal literal = mapping.Literal(i);
+        assumptions.push_back(domain.FixedValue() == 1 ? literal
+                                                       : literal.Negated());
+      } else if (mapping.IsInteger(i)) {
+        const IntegerVariable var = mapping.Integer(i);
+        if (domain.Min() > integer_trail->LevelZeroLowerBound(var)) {
+          assumptions.push_back(encoder->GetOrCreateAssociatedLiteral(
+              IntegerLiteral::GreaterOrEqual(var, IntegerValue(domain.Min()))));
+        }
+        if (domain.Max() < integer_trail->LevelZeroUpperBound(var)) {
+          assumptions.push_back(encoder->GetOrCreateAssociatedLiteral(
+              IntegerLiteral::LowerOrEqual(var, IntegerValue(domain.Max()))));
+        }
+      }
+    }
+
+    // Each new solution restricts the objective of the next search, through
+    // an assumption so that the model stays valid for the next neighborhoods.
+    const bool has_objective = model_proto.has_objective();
+    IntegerValue objective_bound = base_objective - 1;
+    std::vector<int64_t> best_solution;
+    SatSolver::Status status = SatSolver::INFEASIBLE;
+    while (model_is_feasible) {
+      std::vector<Literal> local_assumptions = assumptions;
+      if (has_objective) {
+        if (!sat_solver->ResetToLevelZero()) break;
+        local_assumptions.push_back(encoder->GetOrCreateAssociatedLiteral(
+            IntegerLiteral::LowerOrEqual(
+                model->GetOrCreate<ObjectiveDefinition>()->objective_var,
+                objective_bound)));
+      }
+      status = ResetAndSolveIntegerProblem(local_assumptions, model);
+      if (status != SatSolver::FEASIBLE) break;
+      best_solution = GetSolutionValues(model_proto, *model);
+      if (!has_objective) break;
+      objective_bound = IntegerValue(ComputeInnerObjective(
+                            model_proto.objective(), best_solution)) -
+                        1;
+    }
+    if (status == SatSolver::INFEASIBLE) model_is_feasible = false;
+
+    const bool fully_solved = status == SatSolver::INFEASIBLE ||
+                              status == SatSolver::ASSUMPTIONS_UNSAT;
+    if (!best_solution.empty()) {
+      response->set_status(fully_solved ? CpSolverStatus::OPTIMAL
+                                        : CpSolverStatus::FEASIBLE);
+      response->mutable_solution()->Assign(best_solution.begin(),
+                                           best_solution.end());
+    } else if (fully_solved && has_objective) {
+      response->set_status(CpSolverStatus::OPTIMAL);
+      *response->mutable_solution() = base_response.solution();
+    } else if (fully_solved) {
+      response->set_status(CpSolverStatus::INFEASIBLE);
+    }
+
+    *deterministic_time = time_limit->GetElapsedDeterministicTime();
+    if (model_is_feasible) {
+      shared_->lns_models->Release(model_params, std::move(loaded_model));
+    }
+    return true;
+  }
+
+  // Copies, presolves and solves the fragment of the model defined by the
+  // neighborhood. The solution of the response is expressed on the variables
+  // of the initial model. Returns false if the fragment could not be created.
+  bool SolveFragment(int64_t task_id, const std::string& lns_info,
+                     const SatParameters& local_params,
+                     Neighborhood* neighborhood, CpModelProto* debug_copy,
+                     CpSolverResponse* response, double* deterministic_time) {
+    Model local_model(lns_info);
+    *(local_model.GetOrCreate<SatParameters>()) = local_params;
+    TimeLimit* local_time_limit = local_model.GetOrCreate<TimeLimit>();
+    local_time_limit->ResetLimitFromParameters(local_params);
+    shared_->time_limit->UpdateLocalLimit(local_time_limit);
+    if (shared_->cut_generator_pool != nullptr) {
+      local_model.Register<CutGeneratorThreadPool>(
+          shared_->cut_generator_pool);
+    }
+
+    // Presolve and solve the LNS fragment.
+    CpModelProto lns_fragment;
+    CpModelProto mapping_proto;
+    auto context = std::make_unique<PresolveContext>(
+        &local_model, &lns_fragment, &mapping_proto);
+
+    *lns_fragment.mutable_variables() = neighborhood->delta.variables();
+    {
+      ModelCopy copier(context.get());
+
+      // Copy and simplify the constraints from the initial model.
+      if (!copier.ImportAndSimplifyConstraints(
+              helper_->ModelProto(), neighborhood->constraints_to_ignore)) {
+        return false;
+      }
+
+      // Copy and simplify the constraints from the delta model.
+      if (!neighborhood->delta.constraints().empty() &&
+          !copier.ImportAndSimplifyConstraints(neighborhood->delta, {})) {
+        return false;
+      }
+    }
+
+    // Copy the rest of the model and overwrite the name.
+    CopyEverythingExceptVariablesAndConstraintsFieldsIntoContext(
+        helper_->ModelProto(), context.get());
+    lns_fragment.set_name(absl::StrCat("lns_", task_id));
+
+    // Overwrite solution hinting.
+    if (neighborhood->delta.has_solution_hint()) {
+      *lns_fragment.mutable_solution_hint() =
+          neighborhood->delta.solution_hint();
+    }
+
+    if (absl::GetFlag(FLAGS_cp_model_dump_problematic_lns)) {
+      // We need to make a copy because the presolve is destructive.
+      // It is why we do not do that by default.
+      *debug_copy = lns_fragment;
+    }
+
+#if !defined(__PORTABLE_PLATFORM__)
+#endif  // __PORTABLE_PLATFORM__
+
+    if (absl::GetFlag(FLAGS_cp_model_dump_lns)) {
+      // TODO(user): export the delta too if needed.
+      const std::string lns_name =
+          absl::StrCat(absl::GetFlag(FLAGS_cp_model_dump_prefix),
+                       lns_fragment.name(), ".pb.txt");
+      LOG(INFO) << "Dumping LNS model to '" << lns_name << "'.";
+      CHECK(WriteModelProtoToFile(lns_fragment, lns_name));
+    }
+
+    std::vector<int> postsolve_mapping;
+    const CpSolverStatus presolve_status =
+        PresolveCpModel(context.get(), &postsolve_mapping);
+
+    // Release the context.
+    context.reset(nullptr);
+    neighborhood->delta.Clear();
+
+    // TODO(user): Depending on the problem, we should probably use the
+    // parameters that work bests (core, linearization_level, etc...) or
+    // maybe we can just randomize them like for the base solution used.
+    auto* local_response_manager =
+        local_model.GetOrCreate<SharedResponseManager>();
+    local_response_manager->InitializeObjective(lns_fragment);
+    local_response_manager->SetSynchronizationMode(true);
+
+    CpSolverResponse local_response;
+    if (presolve_status == CpSolverStatus::UNKNOWN) {
+      LoadCpModel(lns_fragment, &local_model);
+      QuickSolveWithHint(lns_fragment, &local_model);
+      SolveLoadedCpModel(lns_fragment, &local_model);
+      local_response = local_response_manager->GetResponse();
+      // In case the LNS model is empty after presolve, the solution
+      // repository does not add the solution, and thus does not store the
+      // solution info. In that case, we put it back.
+      if (local_response.solution_info().empty()) {
+        local_response.set_solution_info(absl::StrCat(lns_info, " [presolve]"));
+      }
+    } else {
+      // TODO(user): Clean this up? when the model is closed by presolve,
+      // we don't have a nice api to get the response with stats. That said
+      // for LNS, we don't really need it.
+      if (presolve_status == CpSolverStatus::INFEASIBLE) {
+        local_response_manager->NotifyThatImprovingProblemIsInfeasible(
+            "presolve");
+      }
+      local_response = local_response_manager->GetResponse();
+      local_response.set_status(presolve_status);
+    }
+
+    // TODO(user): we actually do not need to postsolve if the solution is
+    // not going to be used...
+    if (local_response.status() == CpSolverStatus::OPTIMAL ||
+        local_response.status() == CpSolverStatus::FEASIBLE) {
+      std::vector<int64_t> solution_values(local_response.solution().begin(),
+                                           local_response.solution().end());
+      PostsolveResponseWrapper(
+          local_params, helper_->ModelProto().variables_size(), mapping_proto,
+          postsolve_mapping, &solution_values);
+      local_response.mutable_solution()->Assign(solution_values.begin(),
+                                                solution_values.end());
+    }
+
+    *deterministic_time = local_time_limit->GetElapsedDeterministicTime();
+    *response = std::move(local_response);
+    return true;
+  }
+
   std::unique_ptr<NeighborhoodGenerator> generator_;
   NeighborhoodGeneratorHelper* helper_;
   const SatParameters parameters_;
@@ -3085,6 +3424,45 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
     shared_clauses = std::make_unique<SharedClausesManager>(always_synchronize);
   }
 
+  std::unique_ptr<SharedCutsManager> shared_cuts;
+  if (params.share_linear_cuts()) {
+    shared_cuts = std::make_unique<SharedCutsManager>(always_synchronize);
+  }
+
+  // The lb_tree_search workers share the top of their search tree if there
+  // are more than one of them.
+  const std::vector<SatParameters> full_problem_params =
+      params.use_lns_only() ? std::vector<SatParameters>()
+                            : GetDiverseSetOfParameters(params, model_proto);
+  std::unique_ptr<SharedLbTreeManager> shared_lb_tree;
+  if (params.share_lb_tree_search_tree() && model_proto.has_objective()) {
+    int num_lb_tree_search_workers = 0;
+    for (const SatParameters& local_params : full_problem_params) {
+      if (local_params.optimize_with_lb_tree_search()) {
+        ++num_lb_tree_search_workers;
+      }
+    }
+    if (num_lb_tree_search_workers > 1) {
+      shared_lb_tree = std::make_unique<SharedLbTreeManager>(
+          model_proto, num_lb_tree_search_workers,
+          global_model->GetOrCreate<SharedResponseManager>());
+      if (shared_lb_tree->NumLeaves() <= 1) shared_lb_tree.reset();
+    }
+  }
+
+  // All the workers generate their cuts with the same threads.
+  CutGeneratorThreadPool* const cut_generator_pool =
+      params.num_cut_generator_threads() > 0
+          ? global_model->GetOrCreate<CutGeneratorThreadPool>()
+          : nullptr;
+
+  std::unique_ptr<PersistentLnsModels> lns_models;
+  if (params.lns_use_persistent_models() && !params.interleave_search()) {
+    lns_models = std::make_unique<PersistentLnsModels>(
+        model_proto, global_model->GetOrCreate<ModelSharedTimeLimit>(),
+        shared_bounds_manager.get(), cut_generator_pool);
+  }
+
   SharedResponseManager* shared_response_manager =
       global_model->GetOrCreate<SharedResponseManager>();
   shared_response_manager->SetSynchronizationMode(always_synchronize);
@@ -3099,6 +3477,10 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
   shared.lp_solutions = shared_lp_solutions.get();
   shared.incomplete_solutions = shared_incomplete_solutions.get();
   shared.clauses = shared_clauses.get();
+  shared.cuts = shared_cuts.get();
+  shared.lb_tree = shared_lb_tree.get();
+  shared.lns_models = lns_models.get();
+  shared.cut_generator_pool = cut_generator_pool;
   shared.global_model = global_model;
 
   // The list of all the SubSolver that will be used in this parallel search.
@@ -3122,6 +3504,9 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
         if (shared.clauses != nullptr) {
           shared.clauses->Synchronize();
         }
+        if (shared.cuts != nullptr) {
+          shared.cuts->Synchronize();
+        }
         if (shared.time_limit->LimitReached()) {
           *(shared.response->first_solution_solvers_should_stop()) = true;
         }
@@ -3142,8 +3527,7 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
         "first_solution", local_params,
         /*split_in_chunks=*/false, &shared));
   } else {
-    for (const SatParameters& local_params :
-         GetDiverseSetOfParameters(params, model_proto)) {
+    for (const SatParameters& local_params : full_problem_params) {
       // TODO(user): This is currently not supported here.
       if (params.optimize_with_max_hs()) continue;
 
@@ -3272,6 +3656,32 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
           local_params, helper, &shared));
     }
 
+    // These generators exploit the diversity of the solutions in the pool, or
+    // the distance to the base solution on the Boolean variables.
+    if (params.use_crossover_and_local_branching_lns()) {
+      if (params.solution_pool_size() > 1) {
+        subsolvers.push_back(std::make_unique<LnsSolver>(
+            std::make_unique<SolutionCrossoverNeighborhoodGenerator>(
+                helper, absl::StrCat("crossover_lns_", local_params.name())),
+            local_params, helper, &shared));
+      }
+      bool has_booleans = false;
+      for (const IntegerVariableProto& var_proto : model_proto.variables()) {
+        if (var_proto.domain_size() == 2 && var_proto.domain(0) == 0 &&
+            var_proto.domain(1) == 1) {
+          has_booleans = true;
+          break;
+        }
+      }
+      if (has_booleans) {
+        subsolvers.push_back(std::make_unique<LnsSolver>(
+            std::make_unique<LocalBranchingNeighborhoodGenerator>(
+                helper,
+                absl::StrCat("local_branching_lns_", local_params.name())),
+            local_params, helper, &shared));
+      }
+    }
+
     // TODO(user): If we have a model with scheduling + routing. We create
     // a lot of LNS generators. Investigate if we can reduce this number.
     if (!helper->TypeToConstraints(ConstraintProto::kNoOverlap).empty() ||
@@ -3435,6 +3845,10 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
     if (shared.clauses) {
       shared.clauses->LogStatistics(logger);
     }
+
+    if (shared.cuts) {
+      shared.cuts->LogStatistics(logger);
+    }
   }
 
   // We delete manually as windows release vectors in the opposite order.
@@ -3498,6 +3912,323 @@ void TestSolutionHintForFeasibility(const CpModelProto& model_proto,
   }
 }
 
+#if !defined(__PORTABLE_PLATFORM__)
+
+// If the given presolved model is made of several independent components,
+// solves them concurrently and combines their solutions and objective bounds
+// in the SharedResponseManager of the given model. The components are split
+// into at most num_workers groups of similar sizes, and each group is solved
+// by a call to SolveCpModel() with a number of workers proportional to its
+// size. Returns false without doing anything if the model is not decomposed.
+bool SolveIndependentComponents(const CpModelProto& model_proto, Model* model) {
+  const SatParameters& params = *model->GetOrCreate<SatParameters>();
+  if (params.num_workers() <= 1 || params.enumerate_all_solutions() ||
+      params.interleave_search() || !params.subsolvers().empty()) {
+    return false;
+  }
+  if (model_proto.has_symmetry() || !model_proto.search_strategy().empty() ||
+      !model_proto.assumptions().empty() ||
+      model_proto.has_floating_point_objective()) {
+    return false;
+  }
+
+  // The objective domain must not link the components together, so we only
+  // decompose if it does not restrict the possible objective values.
+  const int num_variables = model_proto.variables_size();
+  if (model_proto.has_objective()) {
+    const CpObjectiveProto& objective = model_proto.objective();
+    int64_t min_activity = 0;
+    int64_t max_activity = 0;
+    for (int i = 0; i < objective.vars_size(); ++i) {
+      if (!RefIsPositive(objective.vars(i))) return false;
+      const Domain domain =
+          ReadDomainFromProto(model_proto.variables(objective.vars(i)));
+      const int64_t a = CapProd(objective.coeffs(i), domain.Min());
+      const int64_t b = CapProd(objective.coeffs(i), domain.Max());
+      min_activity = CapAdd(min_activity, std::min(a, b));
+      max_activity = CapAdd(max_activity, std::max(a, b));
+    }
+    if (!objective.domain().empty() &&
+        !Domain(min_activity, max_activity)
+             .IsIncludedIn(ReadDomainFromProto(objective))) {
+      return false;
+    }
+  }
+
+  // Compute the connected components of the variables <-> constraints graph.
+  // The nodes [0, num_variables) are the variables, and the other ones are the
+  // constraints. An interval is linked to the constraints using it.
+  const int num_constraints = model_proto.constraints_size();
+  DenseConnectedComponentsFinder finder;
+  finder.SetNumberOfNodes(num_variables + num_constraints);
+  for (int c = 0; c < num_constraints; ++c) {
+    const ConstraintProto& ct = model_proto.constraints(c);
+    for (const int var : UsedVariables(ct)) {
+      finder.AddEdge(num_variables + c, var);
+    }
+    for (const int interval : UsedIntervals(ct)) {
+      finder.AddEdge(num_variables + c, num_variables + interval);
+    }
+  }
+  const int num_components = finder.GetNumberOfComponents();
+  const std::vector<int> node_to_component = finder.GetComponentIds();
+  std::vector<int> component_sizes(num_components, 0);
+  std::vector<bool> has_variable(num_components, false);
+  for (int node = 0; node < node_to_component.size(); ++node) {
+    ++component_sizes[node_to_component[node]];
+    if (node < num_variables) has_variable[node_to_component[node]] = true;
+  }
+  std::vector<int> components;
+  for (int c = 0; c < num_components; ++c) {
+    if (has_variable[c]) components.push_back(c);
+  }
+  if (components.size() <= 1) return false;
+
+  // Only the components with at least independent_components_min_size nodes
+  // get their own group, the smaller ones are just packed with them. It is
+  // not worth solving separately a few tiny components, and each group takes
+  // at least one worker.
+  int num_large_components = 0;
+  for (const int c : components) {
+    if (component_sizes[c] >= params.independent_components_min_size()) {
+      ++num_large_components;
+    }
+  }
+  const int num_groups =
+      std::min<int>(num_large_components, params.num_workers());
+  if (num_groups <= 1) return false;
+
+  // Assign the largest components first, each to the currently smallest group.
+  // The constraints without any variable all go to the first group.
+  std::sort(components.begin(), components.end(), [&](int a, int b) {
+    if (component_sizes[a] != component_sizes[b]) {
+      return component_sizes[a] > component_sizes[b];
+    }
+    return a < b;
+  });
+  std::vector<int64_t> group_sizes(num_groups, 0);
+  std::vector<int> component_to_group(num_components, 0);
+  for (const int c : components) {
+    const int g = std::min_element(group_sizes.begin(), group_sizes.end()) -
+                  group_sizes.begin();
+    component_to_group[c] = g;
+    group_sizes[g] += component_sizes[c];
+  }
+
+  // Each group has at least one worker, and the others are given one by one
+  // to the group with the largest size per worker.
+  std::vector<int> group_num_workers(num_groups, 1);
+  for (int i = num_groups; i < params.num_workers(); ++i) {
+    int best = 0;
+    for (int g = 1; g < num_groups; ++g) {
+      if (group_sizes[g] * group_num_workers[best] >
+          group_sizes[best] * group_num_workers[g]) {
+        best = g;
+      }
+    }
+    ++group_num_workers[best];
+  }
+
+  // Create one model per group, with its variables and constraints reindexed.
+  std::vector<CpModelProto> sub_models(num_groups);
+  std::vector<std::vector<int>> group_variables(num_groups);
+  std::vector<int> local_variables(num_variables);
+  for (int var = 0; var < num_variables; ++var) {
+    const int g = component_to_group[node_to_component[var]];
+    local_variables[var] = group_variables[g].size();
+    group_variables[g].push_back(var);
+    *sub_models[g].add_variables() = model_proto.variables(var);
+  }
+  std::vector<int> local_constraints(num_constraints);
+  for (int c = 0; c < num_constraints; ++c) {
+    const int g = component_to_group[node_to_component[num_variables + c]];
+    local_constraints[c] = sub_models[g].constraints_size();
+    *sub_models[g].add_constraints() = model_proto.constraints(c);
+  }
+  const std::function<void(int*)> map_ref = [&local_variables](int* ref) {
+    *ref = RefIsPositive(*ref) ? local_variables[*ref]
+                               : NegatedRef(local_variables[PositiveRef(*ref)]);
+  };
+  const std::function<void(int*)> map_interval =
+      [&local_constraints](int* c) { *c = local_constraints[*c]; };
+  for (CpModelProto& sub_model : sub_models) {
+    for (ConstraintProto& ct : *sub_model.mutable_constraints()) {
+      ApplyToAllVariableIndices(map_ref, &ct);
+      ApplyToAllLiteralIndices(map_ref, &ct);
+      ApplyToAllIntervalIndices(map_interval, &ct);
+    }
+  }
+
+  // Split the objective. A group without any objective term is just solved
+  // as a feasibility problem. Since the offset and scaling are kept in the
+  // main model, the inner objective is the sum of the group objectives.
+  std::vector<IntegerValue> group_lower_bounds(num_groups, IntegerValue(0));
+  if (model_proto.has_objective()) {
+    const CpObjectiveProto& objective = model_proto.objective();
+    for (int i = 0; i < objective.vars_size(); ++i) {
+      const int var = objective.vars(i);
+      const int64_t coeff = objective.coeffs(i);
+      const int g = component_to_group[node_to_component[var]];
+      CpObjectiveProto* sub_objective = sub_models[g].mutable_objective();
+      sub_objective->add_vars(local_variables[var]);
+      sub_objective->add_coeffs(coeff);
+      const Domain domain = ReadDomainFromProto(model_proto.variables(var));
+      group_lower_bounds[g] = IntegerValue(
+          CapAdd(group_lower_bounds[g].value(),
+                 std::min(CapProd(coeff, domain.Min()),
+                          CapProd(coeff, domain.Max()))));
+    }
+  }
+  if (model_proto.has_solution_hint()) {
+    const PartialVariableAssignment& hint = model_proto.solution_hint();
+    for (int i = 0; i < hint.vars_size(); ++i) {
+      const int ref = hint.vars(i);
+      const int g = component_to_group[node_to_component[PositiveRef(ref)]];
+      PartialVariableAssignment* sub_hint =
+          sub_models[g].mutable_solution_hint();
+      int local_ref = ref;
+      map_ref(&local_ref);
+      sub_hint->add_vars(local_ref);
+      sub_hint->add_values(hint.values(i));
+    }
+  }
+
+  SolverLogger* logger = model->GetOrCreate<SolverLogger>();
+  SOLVER_LOG(logger, "");
+  SOLVER_LOG(logger, "Solving ", components.size(),
+             " independent components in ", num_groups,
+             " groups with workers: ", absl::StrJoin(group_num_workers, ","));
+
+  auto* shared_response_manager = model->GetOrCreate<SharedResponseManager>();
+  auto* shared_time_limit = model->GetOrCreate<ModelSharedTimeLimit>();
+  shared_response_manager->InitializeComponents(std::move(group_variables),
+                                                group_lower_bounds);
+  const double time_left = shared_time_limit->GetTimeLeft();
+  const double deterministic_time_left =
+      model->GetOrCreate<TimeLimit>()->GetDeterministicTimeLeft();
+
+  // The sub-model objectives have no offset nor scaling, so their bounds are
+  // integer, up to the floating point errors.
+  const auto update_group_lower_bound = [shared_response_manager](
+                                            int g, double bound,
+                                            const std::string& info) {
+    if (!std::isfinite(bound) || std::abs(bound) > 1e18) return;
+    const int64_t lb = static_cast<int64_t>(std::ceil(bound - 1e-6));
+    shared_response_manager->UpdateComponentLowerBound(g, IntegerValue(lb),
+                                                       info);
+  };
+
+  // We do not share the stop Boolean of our time limit with the groups, since
+  // a group that is done would stop all the others. Instead, we stop them from
+  // here once we are done or our limit is reached.
+  std::deque<std::atomic<bool>> stop_groups(num_groups);
+  std::vector<CpSolverResponse> group_responses(num_groups);
+  absl::Mutex mutex;
+  int num_running = num_groups;
+  std::vector<std::thread> threads;
+  for (int g = 0; g < num_groups; ++g) {
+    threads.emplace_back([&, g]() {
+      const std::string info = absl::StrCat("component_", g);
+      Model sub_model(info);
+      SatParameters* sub_params = sub_model.GetOrCreate<SatParameters>();
+      *sub_params = params;
+      sub_params->set_num_workers(group_num_workers[g]);
+      sub_params->set_solve_independent_components(false);
+      sub_params->set_log_search_progress(false);
+      sub_params->set_log_to_response(false);
+      sub_params->set_catch_sigint_signal(false);
+      sub_params->set_fill_tightened_domains_in_response(false);
+      sub_params->set_max_time_in_seconds(time_left);
+      sub_params->set_max_deterministic_time(deterministic_time_left);
+      sub_model.GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(
+          &stop_groups[g]);
+
+      const CpModelProto& sub_model_proto = sub_models[g];
+      sub_model.Add(NewFeasibleSolutionObserver(
+          [&, g, info](const CpSolverResponse& response) {
+            const IntegerValue objective(
+                sub_model_proto.has_objective()
+                    ? ComputeInnerObjective(sub_model_proto.objective(),
+                                            response.solution())
+                    : 0);
+            shared_response_manager->NewComponentSolution(
+                g, objective, response.solution(), info);
+          }));
+      if (sub_model_proto.has_objective()) {
+        sub_model.GetOrCreate<SharedResponseManager>()->AddBestBoundCallback(
+            [&, g, info](double bound) {
+              update_group_lower_bound(g, bound, info);
+            });
+      }
+      group_responses[g] = SolveCpModel(sub_model_proto, &sub_model);
+
+      // The groups are solved without any constraint on their objective, so
+      // an infeasible group means that the whole problem is infeasible, and
+      // the other groups can stop right away.
+      if (group_responses[g].status() == CpSolverStatus::INFEASIBLE) {
+        if (!shared_response_manager->ProblemIsSolved()) {
+          shared_response_manager->NotifyThatImprovingProblemIsInfeasible(
+              info);
+        }
+        for (std::atomic<bool>& stop : stop_groups) stop = true;
+      }
+
+      absl::MutexLock lock(&mutex);
+      --num_running;
+    });
+  }
+
+  {
+    absl::MutexLock lock(&mutex);
+    while (num_running > 0) {
+      if (shared_time_limit->LimitReached() ||
+          shared_response_manager->ProblemIsSolved()) {
+        for (std::atomic<bool>& stop : stop_groups) stop = true;
+      }
+      mutex.AwaitWithTimeout(
+          absl::Condition(+[](int* num_running) { return *num_running == 0; },
+                          &num_running),
+          absl::Milliseconds(10));
+    }
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  // Use the final objective bound of each group, which is its objective value
+  // if it was solved to optimality.
+  CpSolverResponse stats_response;
+  for (int g = 0; g < num_groups; ++g) {
+    const CpSolverResponse& response = group_responses[g];
+    const std::string info = absl::StrCat("component_", g);
+    shared_time_limit->AdvanceDeterministicTime(response.deterministic_time());
+    if (sub_models[g].has_objective() &&
+        response.status() == CpSolverStatus::OPTIMAL) {
+      update_group_lower_bound(g, response.best_objective_bound(), info);
+    }
+    stats_response.set_num_booleans(stats_response.num_booleans() +
+                                    response.num_booleans());
+    stats_response.set_num_integers(stats_response.num_integers() +
+                                    response.num_integers());
+    stats_response.set_num_branches(stats_response.num_branches() +
+                                    response.num_branches());
+    stats_response.set_num_conflicts(stats_response.num_conflicts() +
+                                     response.num_conflicts());
+    stats_response.set_num_binary_propagations(
+        stats_response.num_binary_propagations() +
+        response.num_binary_propagations());
+    stats_response.set_num_integer_propagations(
+        stats_response.num_integer_propagations() +
+        response.num_integer_propagations());
+    stats_response.set_num_restarts(stats_response.num_restarts() +
+                                    response.num_restarts());
+    stats_response.set_num_lp_iterations(stats_response.num_lp_iterations() +
+                                         response.num_lp_iterations());
+  }
+  shared_response_manager->AppendResponseToBeMerged(stats_response);
+  return true;
+}
+
+#endif  // __PORTABLE_PLATFORM__
+
 }  // namespace
 
 CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
@@ -4047,8 +4778,11 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
   if (/* DISABLES CODE */ (false)) {
     // We ignore the multithreading parameter in this case.
 #else   // __PORTABLE_PLATFORM__
-  if (params.num_workers() > 1 || params.interleave_search() ||
-      !params.subsolvers().empty()) {
+  if (params.solve_independent_components() &&
+      SolveIndependentComponents(new_cp_model_proto, model)) {
+    // Done, the components were solved concurrently.
+  } else if (params.num_workers() > 1 || params.interleave_search() ||
+             !params.subsolvers().empty()) {
     SolveCpModelParallel(new_cp_model_proto, model);
 #endif  // __PORTABLE_PLATFORM__
   } else if (!model->GetOrCreate<TimeLimit>()->LimitReached()) {
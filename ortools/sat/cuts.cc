@@ -1305,6 +1305,7 @@ CutGenerator CreatePositiveMultiplicationCutGenerator(AffineExpression z,
   IntegerTrail* const integer_trail = model->GetOrCreate<IntegerTrail>();
   Trail* trail = model->GetOrCreate<Trail>();
 
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [z, x, y, linearization_level, model, trail, integer_trail](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
@@ -1422,6 +1423,7 @@ CutGenerator CreateSquareCutGenerator(AffineExpression y, AffineExpression x,
 
   Trail* trail = model->GetOrCreate<Trail>();
   IntegerTrail* integer_trail = model->GetOrCreate<IntegerTrail>();
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [y, x, linearization_level, trail, integer_trail, model](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
@@ -2085,6 +2087,7 @@ CutGenerator CreateAllDifferentCutGenerator(
   gtl::STLSortAndRemoveDuplicates(&result.vars);
 
   Trail* trail = model->GetOrCreate<Trail>();
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [exprs, integer_trail, trail, model](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
@@ -2203,6 +2206,7 @@ CutGenerator CreateLinMaxCutGenerator(
   result.vars.insert(result.vars.end(), x_vars.begin(), x_vars.end());
 
   IntegerTrail* integer_trail = model->GetOrCreate<IntegerTrail>();
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [x_vars, z_vars, target, num_exprs, exprs, integer_trail, model](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
@@ -2316,6 +2320,7 @@ CutGenerator CreateMaxAffineCutGenerator(
   gtl::STLSortAndRemoveDuplicates(&result.vars);
 
   IntegerTrail* integer_trail = model->GetOrCreate<IntegerTrail>();
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [target, var, affines, cut_name, integer_trail, model](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
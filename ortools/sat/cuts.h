@@ -47,6 +47,10 @@ namespace sat {
 // - Only add cuts in term of the same variables or their negation.
 struct CutGenerator {
   bool only_run_at_level_zero = false;
+  // If true, generate_cuts() only reads the current bounds and lp_values, and
+  // only calls AddCut() on the given manager. It can then run concurrently with
+  // the other generators with this property, see num_cut_generator_threads.
+  bool can_run_concurrently = false;
   std::vector<IntegerVariable> vars;
   std::function<bool(
       const absl::StrongVector<IntegerVariable, double>& lp_values,
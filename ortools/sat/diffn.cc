@@ -286,14 +286,24 @@ bool NonOverlappingRectanglesDisjunctivePropagator::
 
   // Less than 2 boxes, no propagation.
   if (indexed_intervals_.size() < 2) return true;
-  ConstructOverlappingSets(/*already_sorted=*/true, &indexed_intervals_,
-                           &events_overlapping_boxes_);
+
+  // Only recompute the overlapping sets if the mandatory parts changed since
+  // the last propagation in the same dimension. Note that the sets are only
+  // reordered below, so they stay valid.
+  const int dim = y == &global_y_ ? 0 : 1;
+  std::vector<std::vector<int>>& overlapping_boxes =
+      events_overlapping_boxes_[dim];
+  if (indexed_intervals_ != last_mandatory_parts_[dim]) {
+    last_mandatory_parts_[dim] = indexed_intervals_;
+    ConstructOverlappingSets(/*already_sorted=*/true, &indexed_intervals_,
+                             &overlapping_boxes);
+  }
 
   // Split lists of boxes into disjoint set of boxes (w.r.t. overlap).
   boxes_to_propagate_.clear();
   reduced_overlapping_boxes_.clear();
-  for (int i = 0; i < events_overlapping_boxes_.size(); ++i) {
-    SplitDisjointBoxes(x, absl::MakeSpan(events_overlapping_boxes_[i]),
+  for (int i = 0; i < overlapping_boxes.size(); ++i) {
+    SplitDisjointBoxes(x, absl::MakeSpan(overlapping_boxes[i]),
                        &disjoint_boxes_);
     for (absl::Span<int> sub_boxes : disjoint_boxes_) {
       // Boxes are sorted in a stable manner in the Split method.
@@ -66,7 +66,13 @@ class NonOverlappingRectanglesDisjunctivePropagator
   int fast_id_;  // Propagator id of the "fast" version.
 
   std::vector<IndexedInterval> indexed_intervals_;
-  std::vector<std::vector<int>> events_overlapping_boxes_;
+
+  // The mandatory parts used by the last call to ConstructOverlappingSets()
+  // and its result, for the propagation on x (index 0) and on y (index 1).
+  // The mandatory parts rarely change between two calls, so this avoids
+  // recomputing the overlapping sets, whose size can be quadratic.
+  std::vector<IndexedInterval> last_mandatory_parts_[2];
+  std::vector<std::vector<int>> events_overlapping_boxes_[2];
 
   absl::flat_hash_set<absl::Span<int>> reduced_overlapping_boxes_;
   std::vector<absl::Span<int>> boxes_to_propagate_;
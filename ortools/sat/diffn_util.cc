@@ -16,6 +16,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <numeric>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -42,24 +43,71 @@ std::vector<absl::Span<int>> GetOverlappingRectangleComponents(
     const std::vector<Rectangle>& rectangles,
     absl::Span<int> active_rectangles) {
   if (active_rectangles.empty()) return {};
-
-  std::vector<absl::Span<int>> result;
   const int size = active_rectangles.size();
-  for (int start = 0; start < size;) {
-    // Find the component of active_rectangles[start].
-    int end = start + 1;
-    for (int i = start; i < end; i++) {
-      for (int j = end; j < size; ++j) {
-        if (!rectangles[active_rectangles[i]].IsDisjoint(
-                rectangles[active_rectangles[j]])) {
-          std::swap(active_rectangles[end++], active_rectangles[j]);
-        }
-      }
+
+  // We sweep the rectangles by increasing x_min and only test for overlap the
+  // ones that were not left behind by the sweep line, that is the ones with a
+  // x_max after the current x_min. The components are merged with a
+  // union-find over the positions in active_rectangles.
+  std::vector<int> by_x_min(size);
+  std::iota(by_x_min.begin(), by_x_min.end(), 0);
+  std::sort(by_x_min.begin(), by_x_min.end(),
+            [&rectangles, active_rectangles](int a, int b) {
+              return rectangles[active_rectangles[a]].x_min <
+                     rectangles[active_rectangles[b]].x_min;
+            });
+  std::vector<int> parent(size);
+  std::iota(parent.begin(), parent.end(), 0);
+  const auto find_root = [&parent](int i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
     }
-    if (end > start + 1) {
-      result.push_back(active_rectangles.subspan(start, end - start));
+    return i;
+  };
+  std::vector<int> crossing_sweep_line;
+  for (const int i : by_x_min) {
+    const Rectangle& rectangle = rectangles[active_rectangles[i]];
+    int new_size = 0;
+    for (const int j : crossing_sweep_line) {
+      const Rectangle& other = rectangles[active_rectangles[j]];
+      if (other.x_max <= rectangle.x_min) continue;
+      crossing_sweep_line[new_size++] = j;
+      if (!rectangle.IsDisjoint(other)) parent[find_root(j)] = find_root(i);
     }
-    start = end;
+    crossing_sweep_line.resize(new_size);
+    crossing_sweep_line.push_back(i);
+  }
+
+  // Regroup the components contiguously, by order of first appearance, and
+  // move the singletons at the end.
+  std::vector<int> component_size(size, 0);
+  for (int i = 0; i < size; ++i) ++component_size[find_root(i)];
+  std::vector<int> next_position(size, -1);
+  std::vector<std::pair<int, int>> starts_and_sizes;
+  int num_in_components = 0;
+  for (int i = 0; i < size; ++i) {
+    const int root = find_root(i);
+    if (component_size[root] == 1 || next_position[root] != -1) continue;
+    next_position[root] = num_in_components;
+    starts_and_sizes.push_back({num_in_components, component_size[root]});
+    num_in_components += component_size[root];
+  }
+  if (starts_and_sizes.empty()) return {};
+
+  std::vector<int> regrouped(size);
+  int next_singleton = num_in_components;
+  for (int i = 0; i < size; ++i) {
+    const int root = find_root(i);
+    const int position = component_size[root] == 1 ? next_singleton++
+                                                   : next_position[root]++;
+    regrouped[position] = active_rectangles[i];
+  }
+  std::copy(regrouped.begin(), regrouped.end(), active_rectangles.begin());
+
+  std::vector<absl::Span<int>> result;
+  for (const auto& [start, length] : starts_and_sizes) {
+    result.push_back(active_rectangles.subspan(start, length));
   }
   return result;
 }
@@ -62,6 +62,10 @@ struct Rectangle {
 //
 // This method removes all singleton components. It will modify the
 // active_rectangle span in place.
+//
+// The overlaps are found with a sweep line on x, so the algo is in
+// O(n log n) + O(sum over all rectangles of the number of rectangles crossing
+// the line at its x_min) instead of O(n^2).
 std::vector<absl::Span<int>> GetOverlappingRectangleComponents(
     const std::vector<Rectangle>& rectangles,
     absl::Span<int> active_rectangles);
@@ -1297,8 +1297,8 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
   // - All the non-gray task
   // - All the non-gray task + at most one gray task.
   //
-  // TODO(user): it should be faster to initialize it all at once rather
-  // than calling AddOrUpdate() n times.
+  // The tree is initialized all at once in O(n) with the delayed operations
+  // rather than calling AddOrUpdate() n times.
   const int window_size = window_.size();
   event_size_.clear();
   theta_tree_.Reset(window_size);
@@ -1308,13 +1308,15 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
     const IntegerValue energy_min = helper_->SizeMin(task);
     event_size_.push_back(energy_min);
     if (is_gray_[task]) {
-      theta_tree_.AddOrUpdateOptionalEvent(event, task_time.time, energy_min);
+      theta_tree_.DelayedAddOrUpdateOptionalEvent(event, task_time.time,
+                                                  energy_min);
     } else {
       non_gray_task_to_event_[task] = event;
-      theta_tree_.AddOrUpdateEvent(event, task_time.time, energy_min,
-                                   energy_min);
+      theta_tree_.DelayedAddOrUpdateEvent(event, task_time.time, energy_min,
+                                          energy_min);
     }
   }
+  theta_tree_.RecomputeTreeForDelayedOperations();
 
   // At each iteration we either transform a non-gray task into a gray one or
   // remove a gray task, so this loop is linear in complexity.
@@ -1126,7 +1126,7 @@ void IntegerTrail::RemoveLevelZeroBounds(
 }
 
 std::vector<Literal>* IntegerTrail::InitializeConflict(
-    IntegerLiteral integer_literal, const LazyReasonFunction& lazy_reason,
+    IntegerLiteral integer_literal, const LazyReason* lazy_reason,
     absl::Span<const Literal> literals_reason,
     absl::Span<const IntegerLiteral> bounds_reason) {
   DCHECK(tmp_queue_.empty());
@@ -1141,7 +1141,8 @@ std::vector<Literal>* IntegerTrail::InitializeConflict(
   } else {
     // We use the current trail index here.
     conflict->clear();
-    lazy_reason(integer_literal, integer_trail_.size(), conflict, &tmp_queue_);
+    lazy_reason->Explain(integer_literal, integer_trail_.size(), conflict,
+                         &tmp_queue_);
   }
   return conflict;
 }
@@ -1286,7 +1287,20 @@ bool IntegerTrail::Enqueue(IntegerLiteral i_lit,
 
 bool IntegerTrail::Enqueue(IntegerLiteral i_lit,
                            LazyReasonFunction lazy_reason) {
-  return EnqueueInternal(i_lit, lazy_reason, {}, {}, integer_trail_.size());
+  LazyReason reason;
+  reason.function = std::move(lazy_reason);
+  return EnqueueInternal(i_lit, &reason, {}, {}, integer_trail_.size());
+}
+
+bool IntegerTrail::EnqueueWithLazyReason(IntegerLiteral i_lit, int id,
+                                         IntegerValue propagation_slack,
+                                         LazyReasonInterface* explainer) {
+  DCHECK(explainer != nullptr);
+  LazyReason reason;
+  reason.explainer = explainer;
+  reason.id = id;
+  reason.propagation_slack = propagation_slack;
+  return EnqueueInternal(i_lit, &reason, {}, {}, integer_trail_.size());
 }
 
 bool IntegerTrail::ReasonIsValid(
@@ -1391,7 +1405,7 @@ void IntegerTrail::EnqueueLiteral(
 }
 
 void IntegerTrail::EnqueueLiteralInternal(
-    Literal literal, LazyReasonFunction lazy_reason,
+    Literal literal, const LazyReason* lazy_reason,
     absl::Span<const Literal> literal_reason,
     absl::Span<const IntegerLiteral> integer_reason) {
   DCHECK(!trail_->Assignment().LiteralIsAssigned(literal));
@@ -1418,9 +1432,9 @@ void IntegerTrail::EnqueueLiteralInternal(
   int reason_index = literals_reason_starts_.size();
   if (lazy_reason != nullptr) {
     if (integer_trail_.size() >= lazy_reasons_.size()) {
-      lazy_reasons_.resize(integer_trail_.size() + 1, nullptr);
+      lazy_reasons_.resize(integer_trail_.size() + 1);
     }
-    lazy_reasons_[integer_trail_.size()] = lazy_reason;
+    lazy_reasons_[integer_trail_.size()] = *lazy_reason;
     reason_index = -1;
   } else {
     // Copy the reason.
@@ -1515,7 +1529,7 @@ void IntegerTrail::CanonicalizeLiteralIfNeeded(IntegerLiteral* i_lit) {
 }
 
 bool IntegerTrail::EnqueueInternal(
-    IntegerLiteral i_lit, LazyReasonFunction lazy_reason,
+    IntegerLiteral i_lit, const LazyReason* lazy_reason,
     absl::Span<const Literal> literal_reason,
     absl::Span<const IntegerLiteral> integer_reason,
     int trail_index_with_same_reason) {
@@ -1575,8 +1589,9 @@ bool IntegerTrail::EnqueueInternal(
         // TODO(user): A possible solution would be to support the two types
         // of reason (lazy and not) at the same time and use the union of both?
         if (lazy_reason != nullptr) {
-          lazy_reason(i_lit, integer_trail_.size(), &lazy_reason_literals_,
-                      &lazy_reason_trail_indices_);
+          lazy_reason->Explain(i_lit, integer_trail_.size(),
+                               &lazy_reason_literals_,
+                               &lazy_reason_trail_indices_);
           std::vector<IntegerLiteral> temp;
           for (const int trail_index : lazy_reason_trail_indices_) {
             const TrailEntry& entry = integer_trail_[trail_index];
@@ -1703,9 +1718,9 @@ bool IntegerTrail::EnqueueInternal(
   int reason_index = literals_reason_starts_.size();
   if (lazy_reason != nullptr) {
     if (integer_trail_.size() >= lazy_reasons_.size()) {
-      lazy_reasons_.resize(integer_trail_.size() + 1, nullptr);
+      lazy_reasons_.resize(integer_trail_.size() + 1);
     }
-    lazy_reasons_[integer_trail_.size()] = lazy_reason;
+    lazy_reasons_[integer_trail_.size()] = *lazy_reason;
     reason_index = -1;
   } else if (trail_index_with_same_reason >= integer_trail_.size()) {
     // Save the reason into our internal buffers.
@@ -1797,8 +1812,9 @@ void IntegerTrail::ComputeLazyReasonIfNeeded(int trail_index) const {
   if (reason_index == -1) {
     const TrailEntry& entry = integer_trail_[trail_index];
     const IntegerLiteral literal(entry.var, entry.bound);
-    lazy_reasons_[trail_index](literal, trail_index, &lazy_reason_literals_,
-                               &lazy_reason_trail_indices_);
+    lazy_reasons_[trail_index].Explain(literal, trail_index,
+                                       &lazy_reason_literals_,
+                                       &lazy_reason_trail_indices_);
   }
 }
 
@@ -682,6 +682,28 @@ class IntegerEncoder {
   DISALLOW_COPY_AND_ASSIGN(IntegerEncoder);
 };
 
+// Propagators that want to explain their pushes lazily without allocating a
+// closure for each of them can implement this interface and use
+// IntegerTrail::EnqueueWithLazyReason(). Only the explainer pointer and the
+// small (id, propagation_slack) payload given at push time are stored on the
+// trail, and they are passed back to Explain() if the reason is ever needed.
+//
+// The contract of Explain() is the same as the one of a LazyReasonFunction,
+// see IntegerTrail::Enqueue(). Note that the propagator must still be able to
+// recompute the reason from the payload, so the id usually indexes some data
+// that does not change during the search (like a constraint index).
+class LazyReasonInterface {
+ public:
+  LazyReasonInterface() = default;
+  virtual ~LazyReasonInterface() = default;
+
+  virtual void Explain(int id, IntegerValue propagation_slack,
+                       IntegerLiteral literal_to_explain,
+                       int trail_index_of_literal,
+                       std::vector<Literal>* literals,
+                       std::vector<int>* dependencies) = 0;
+};
+
 // This class maintains a set of integer variables with their current bounds.
 // Bounds can be propagated from an external "source" and this class helps
 // to maintain the reason for each propagation.
@@ -954,6 +976,13 @@ class IntegerTrail : public SatPropagator {
   ABSL_MUST_USE_RESULT bool Enqueue(IntegerLiteral i_lit,
                                     LazyReasonFunction lazy_reason);
 
+  // Same as above, but the reason is given by explainer->Explain(id,
+  // propagation_slack, ...). Contrary to a LazyReasonFunction capturing some
+  // state, this never allocates, which matters for propagators that push a lot.
+  ABSL_MUST_USE_RESULT bool EnqueueWithLazyReason(
+      IntegerLiteral i_lit, int id, IntegerValue propagation_slack,
+      LazyReasonInterface* explainer);
+
   // Sometimes we infer some root level bounds but we are not at the root level.
   // In this case, we will update the level-zero bounds right away, but will
   // delay the current push until the next restart.
@@ -1087,23 +1116,46 @@ class IntegerTrail : public SatPropagator {
   // canonicalized.
   void CanonicalizeLiteralIfNeeded(IntegerLiteral* i_lit);
 
+  // A lazy reason, either given by a LazyReasonFunction or by a
+  // LazyReasonInterface and its payload. The latter is preferred as it is a
+  // lot cheaper to copy.
+  struct LazyReason {
+    LazyReasonFunction function;
+    LazyReasonInterface* explainer = nullptr;
+    int id = 0;
+    IntegerValue propagation_slack = IntegerValue(0);
+
+    void Explain(IntegerLiteral literal_to_explain, int trail_index_of_literal,
+                 std::vector<Literal>* literals,
+                 std::vector<int>* dependencies) const {
+      if (explainer != nullptr) {
+        explainer->Explain(id, propagation_slack, literal_to_explain,
+                           trail_index_of_literal, literals, dependencies);
+      } else {
+        function(literal_to_explain, trail_index_of_literal, literals,
+                 dependencies);
+      }
+    }
+  };
+
   // Called by the Enqueue() functions that detected a conflict. This does some
   // common conflict initialization that must terminate by a call to
   // MergeReasonIntoInternal(conflict) where conflict is the returned vector.
   std::vector<Literal>* InitializeConflict(
-      IntegerLiteral integer_literal, const LazyReasonFunction& lazy_reason,
+      IntegerLiteral integer_literal, const LazyReason* lazy_reason,
       absl::Span<const Literal> literals_reason,
       absl::Span<const IntegerLiteral> bounds_reason);
 
   // Internal implementation of the different public Enqueue() functions.
+  // The lazy_reason, if not nullptr, is used instead of the given reasons.
   ABSL_MUST_USE_RESULT bool EnqueueInternal(
-      IntegerLiteral i_lit, LazyReasonFunction lazy_reason,
+      IntegerLiteral i_lit, const LazyReason* lazy_reason,
       absl::Span<const Literal> literal_reason,
       absl::Span<const IntegerLiteral> integer_reason,
       int trail_index_with_same_reason);
 
   // Internal implementation of the EnqueueLiteral() functions.
-  void EnqueueLiteralInternal(Literal literal, LazyReasonFunction lazy_reason,
+  void EnqueueLiteralInternal(Literal literal, const LazyReason* lazy_reason,
                               absl::Span<const Literal> literal_reason,
                               absl::Span<const IntegerLiteral> integer_reason);
 
@@ -1175,11 +1227,11 @@ class IntegerTrail : public SatPropagator {
 
     // Index in literals_reason_start_/bounds_reason_starts_ If this is -1, then
     // this was a propagation with a lazy reason, and the reason can be
-    // re-created by calling the function lazy_reasons_[trail_index].
+    // re-created by calling lazy_reasons_[trail_index].Explain().
     int32_t reason_index;
   };
   std::vector<TrailEntry> integer_trail_;
-  std::vector<LazyReasonFunction> lazy_reasons_;
+  std::vector<LazyReason> lazy_reasons_;
 
   // Start of each decision levels in integer_trail_.
   // TODO(user): use more general reversible mechanism?
@@ -1201,7 +1253,7 @@ class IntegerTrail : public SatPropagator {
   std::vector<IntegerLiteral> bounds_reason_buffer_;
   mutable std::vector<int> trail_index_reason_buffer_;
 
-  // Temporary vector filled by calls to LazyReasonFunction().
+  // Temporary vector filled by calls to LazyReason::Explain().
   mutable std::vector<Literal> lazy_reason_literals_;
   mutable std::vector<int> lazy_reason_trail_indices_;
 
@@ -176,6 +176,25 @@ std::pair<IntegerValue, IntegerValue> IntegerSumLE::ConditionalLb(
 }
 
 bool IntegerSumLE::Propagate() {
+  if (is_incremental_) {
+    lb_sum_ = IntegerValue(0);
+    const int num_vars = vars_.size();
+    for (int i = 0; i < num_vars; ++i) {
+      const IntegerVariable var = vars_[i];
+      last_lbs_[i] = integer_trail_->LowerBound(var);
+      lb_sum_ += coeffs_[i] * last_lbs_[i];
+      max_variation_tree_[num_leaves_ + i] =
+          (integer_trail_->UpperBound(var) - last_lbs_[i]) * coeffs_[i];
+    }
+    for (int node = num_leaves_ - 1; node > 0; --node) {
+      max_variation_tree_[node] = std::max(max_variation_tree_[2 * node],
+                                           max_variation_tree_[2 * node + 1]);
+    }
+    need_full_recompute_ = false;
+    time_limit_->AdvanceDeterministicTime(static_cast<double>(num_vars) * 1e-9);
+    return PropagateIncrementalSlack();
+  }
+
   // Reified case: If any of the enforcement_literals are false, we ignore the
   // constraint.
   int num_unassigned_enforcement_literal = 0;
@@ -249,50 +268,120 @@ bool IntegerSumLE::Propagate() {
   // upper bound of the last one.
   for (int i = rev_num_fixed_vars_; i < num_vars; ++i) {
     if (max_variations_[i] <= slack) continue;
+    if (!PushUpperBound(i, slack)) return false;
+  }
 
-    // TODO(user): If the new ub fall into an hole of the variable, we can
-    // actually relax the reason more by computing a better slack.
+  return true;
+}
+
+bool IntegerSumLE::IncrementalPropagate(const std::vector<int>& watch_indices) {
+  if (need_full_recompute_) return Propagate();
+  for (const int i : watch_indices) {
+    const IntegerValue lb = integer_trail_->LowerBound(vars_[i]);
+    lb_sum_ += coeffs_[i] * (lb - last_lbs_[i]);
+    last_lbs_[i] = lb;
+  }
+  time_limit_->AdvanceDeterministicTime(
+      static_cast<double>(watch_indices.size()) * 1e-9);
+  return PropagateIncrementalSlack();
+}
+
+void IntegerSumLE::SetLevel(int level) {
+  // The lower bounds decreased, and we do not know which ones.
+  if (level < previous_level_) need_full_recompute_ = true;
+  previous_level_ = level;
+}
+
+bool IntegerSumLE::PropagateIncrementalSlack() {
+  DCHECK(enforcement_literals_.empty());
+  const IntegerValue slack = upper_bound_ - lb_sum_;
+  if (slack < 0) {
+    FillIntegerReason();
+    integer_trail_->RelaxLinearReason(-slack - 1, reason_coeffs_,
+                                      &integer_reason_);
+    return integer_trail_->ReportConflict({}, integer_reason_);
+  }
+
+  // Only the terms whose leaf is above the slack can push. Each visited leaf
+  // ends up below the slack, either because it was stale and is set to the
+  // current max variation of its term, or because the term is pushed.
+  int num_visited_leaves = 0;
+  while (max_variation_tree_[1] > slack) {
+    int node = 1;
+    while (node < num_leaves_) {
+      node = max_variation_tree_[2 * node] > slack ? 2 * node : 2 * node + 1;
+    }
+    ++num_visited_leaves;
+    const int i = node - num_leaves_;
     const IntegerVariable var = vars_[i];
-    const IntegerValue coeff = coeffs_[i];
-    const IntegerValue div = slack / coeff;
-    const IntegerValue new_ub = integer_trail_->LowerBound(var) + div;
-    const IntegerValue propagation_slack = (div + 1) * coeff - slack - 1;
-    if (!integer_trail_->Enqueue(
-            IntegerLiteral::LowerOrEqual(var, new_ub),
-            /*lazy_reason=*/[this, propagation_slack](
-                                IntegerLiteral i_lit, int trail_index,
-                                std::vector<Literal>* literal_reason,
-                                std::vector<int>* trail_indices_reason) {
-              *literal_reason = literal_reason_;
-              trail_indices_reason->clear();
-              reason_coeffs_.clear();
-              const int size = vars_.size();
-              for (int i = 0; i < size; ++i) {
-                const IntegerVariable var = vars_[i];
-                if (PositiveVariable(var) == PositiveVariable(i_lit.var)) {
-                  continue;
-                }
-                const int index =
-                    integer_trail_->FindTrailIndexOfVarBefore(var, trail_index);
-                if (index >= 0) {
-                  trail_indices_reason->push_back(index);
-                  if (propagation_slack > 0) {
-                    reason_coeffs_.push_back(coeffs_[i]);
-                  }
-                }
-              }
-              if (propagation_slack > 0) {
-                integer_trail_->RelaxLinearReason(
-                    propagation_slack, reason_coeffs_, trail_indices_reason);
-              }
-            })) {
-      return false;
+    const IntegerValue lb = integer_trail_->LowerBound(var);
+    IntegerValue max_variation =
+        (integer_trail_->UpperBound(var) - lb) * coeffs_[i];
+    if (max_variation > slack) {
+      if (!PushUpperBound(i, slack)) return false;
+      max_variation = (integer_trail_->UpperBound(var) - lb) * coeffs_[i];
     }
+    SetMaxVariation(i, max_variation);
   }
-
+  time_limit_->AdvanceDeterministicTime(
+      static_cast<double>(num_visited_leaves) * 1e-9);
   return true;
 }
 
+void IntegerSumLE::SetMaxVariation(int i, IntegerValue max_variation) {
+  int node = num_leaves_ + i;
+  max_variation_tree_[node] = max_variation;
+  while (node > 1) {
+    node /= 2;
+    const IntegerValue max = std::max(max_variation_tree_[2 * node],
+                                      max_variation_tree_[2 * node + 1]);
+    if (max_variation_tree_[node] == max) break;
+    max_variation_tree_[node] = max;
+  }
+}
+
+bool IntegerSumLE::PushUpperBound(int i, IntegerValue slack) {
+  // TODO(user): If the new ub fall into an hole of the variable, we can
+  // actually relax the reason more by computing a better slack.
+  const IntegerVariable var = vars_[i];
+  const IntegerValue coeff = coeffs_[i];
+  const IntegerValue div = slack / coeff;
+  const IntegerValue new_ub = integer_trail_->LowerBound(var) + div;
+  const IntegerValue propagation_slack = (div + 1) * coeff - slack - 1;
+  return integer_trail_->EnqueueWithLazyReason(
+      IntegerLiteral::LowerOrEqual(var, new_ub), /*id=*/0, propagation_slack,
+      this);
+}
+
+void IntegerSumLE::Explain(int /*id*/, IntegerValue propagation_slack,
+                           IntegerLiteral literal_to_explain,
+                           int trail_index_of_literal,
+                           std::vector<Literal>* literals_reason,
+                           std::vector<int>* trail_indices_reason) {
+  *literals_reason = literal_reason_;
+  trail_indices_reason->clear();
+  reason_coeffs_.clear();
+  const int size = vars_.size();
+  for (int i = 0; i < size; ++i) {
+    const IntegerVariable var = vars_[i];
+    if (PositiveVariable(var) == PositiveVariable(literal_to_explain.var)) {
+      continue;
+    }
+    const int index =
+        integer_trail_->FindTrailIndexOfVarBefore(var, trail_index_of_literal);
+    if (index >= 0) {
+      trail_indices_reason->push_back(index);
+      if (propagation_slack > 0) {
+        reason_coeffs_.push_back(coeffs_[i]);
+      }
+    }
+  }
+  if (propagation_slack > 0) {
+    integer_trail_->RelaxLinearReason(propagation_slack, reason_coeffs_,
+                                      trail_indices_reason);
+  }
+}
+
 bool IntegerSumLE::PropagateAtLevelZero() {
   // TODO(user): Deal with enforcements. It is just a bit of code to read the
   // value of the literals at level zero.
@@ -338,6 +427,26 @@ bool IntegerSumLE::PropagateAtLevelZero() {
 void IntegerSumLE::RegisterWith(GenericLiteralWatcher* watcher) {
   is_registered_ = true;
   const int id = watcher->Register(this);
+
+  // On small constraints, a full scan is as fast as the incremental
+  // bookkeeping.
+  const int kMinSizeForIncrementalPropagation = 100;
+  if (enforcement_literals_.empty() &&
+      vars_.size() >= kMinSizeForIncrementalPropagation) {
+    is_incremental_ = true;
+    const int num_vars = vars_.size();
+    num_leaves_ = 1;
+    while (num_leaves_ < num_vars) num_leaves_ *= 2;
+    // The padding leaves are never above the slack.
+    max_variation_tree_.assign(2 * num_leaves_, IntegerValue(0));
+    last_lbs_.resize(num_vars);
+    for (int i = 0; i < num_vars; ++i) {
+      watcher->WatchLowerBound(vars_[i], id, i);
+    }
+    watcher->RegisterReversibleClass(id, this);
+    return;
+  }
+
   for (const IntegerVariable& var : vars_) {
     watcher->WatchLowerBound(var, id);
   }
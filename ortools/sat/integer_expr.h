@@ -44,6 +44,13 @@ namespace sat {
 // A really basic implementation of an upper-bounded sum of integer variables.
 // The complexity is in O(num_variables) at each propagation.
 //
+// Large constraints without enforcement literals, like the objective
+// definition, are propagated incrementally once registered: the slack is
+// updated from the watched lower bounds that changed since the last call, and
+// only recomputed from scratch after a backtrack. The terms are also sorted by
+// decreasing maximum variation at registration, so we stop looking for terms
+// to push as soon as this bound is below the slack.
+//
 // Note that we assume that there can be NO integer overflow. This must be
 // checked at model validation time before this is even created.
 //
@@ -55,7 +62,9 @@ namespace sat {
 // TODO(user): When the variables are Boolean, use directly the pseudo-Boolean
 // constraint implementation. But we do need support for enforcement literals
 // there.
-class IntegerSumLE : public PropagatorInterface {
+class IntegerSumLE : public PropagatorInterface,
+                     ReversibleInterface,
+                     LazyReasonInterface {
  public:
   // If refied_literal is kNoLiteralIndex then this is a normal constraint,
   // otherwise we enforce the implication refied_literal => constraint is true.
@@ -71,8 +80,17 @@ class IntegerSumLE : public PropagatorInterface {
   // - For all i, upper-bound of i
   //      <= upper_bound - Sum {individual lower-bound excluding i).
   bool Propagate() final;
+  bool IncrementalPropagate(const std::vector<int>& watch_indices) final;
+  void SetLevel(int level) final;
   void RegisterWith(GenericLiteralWatcher* watcher);
 
+  // The reason of a push made by this constraint. The id is not used since
+  // there is only one constraint per propagator.
+  void Explain(int id, IntegerValue propagation_slack,
+               IntegerLiteral literal_to_explain, int trail_index_of_literal,
+               std::vector<Literal>* literals_reason,
+               std::vector<int>* trail_indices_reason) final;
+
   // Same as Propagate() but only consider current root level bounds. This is
   // mainly useful for the LP propagator since it can find relevant optimal
   // really late in the search tree.
@@ -92,6 +110,18 @@ class IntegerSumLE : public PropagatorInterface {
   // needed just before pushing something.
   void FillIntegerReason();
 
+  // Pushes the upper bound of the term i given the current slack. The reason
+  // is only computed if it is needed during conflict analysis.
+  bool PushUpperBound(int i, IntegerValue slack);
+
+  // The propagation used when is_incremental_ is true, given the current
+  // lb_sum_.
+  bool PropagateIncrementalSlack();
+
+  // Sets the leaf of the term i in max_variation_tree_ and updates its
+  // ancestors.
+  void SetMaxVariation(int i, IntegerValue max_variation);
+
   const std::vector<Literal> enforcement_literals_;
   const IntegerValue upper_bound_;
 
@@ -114,6 +144,20 @@ class IntegerSumLE : public PropagatorInterface {
   std::vector<IntegerValue> coeffs_;
   std::vector<IntegerValue> max_variations_;
 
+  // Only used by the incremental propagation. lb_sum_ is the sum of
+  // coeffs_[i] * last_lbs_[i]. max_variation_tree_ is a binary max tree with
+  // num_leaves_ leaves, the leaf of the term i being at num_leaves_ + i. A leaf
+  // is an upper bound on the current max variation of its term: it is exact
+  // after a full recompute, and since the bounds only get tighter until the
+  // next one, it is only tightened when the propagation visits it.
+  bool is_incremental_ = false;
+  bool need_full_recompute_ = true;
+  int previous_level_ = 0;
+  IntegerValue lb_sum_;
+  std::vector<IntegerValue> last_lbs_;
+  int num_leaves_ = 0;
+  std::vector<IntegerValue> max_variation_tree_;
+
   std::vector<Literal> literal_reason_;
 
   // Parallel vectors.
@@ -223,14 +223,23 @@ bool SchedulingConstraintHelper::UpdateCachedValues(int t) {
   emin = std::max(emin, smin + dmin);
   emax = std::min(emax, smax + dmax);
 
+  if (smin != cached_start_min_[t]) {
+    recompute_by_start_min_ = true;
+    cached_start_min_[t] = smin;
+  }
   if (emin != cached_end_min_[t]) {
     recompute_energy_profile_ = true;
+    recompute_by_end_min_ = true;
+    cached_end_min_[t] = emin;
+  }
+  if (-smax != cached_negated_start_max_[t]) {
+    recompute_by_start_max_ = true;
+    cached_negated_start_max_[t] = -smax;
+  }
+  if (-emax != cached_negated_end_max_[t]) {
+    recompute_by_end_max_ = true;
+    cached_negated_end_max_[t] = -emax;
   }
-
-  cached_start_min_[t] = smin;
-  cached_end_min_[t] = emin;
-  cached_negated_start_max_[t] = -smax;
-  cached_negated_end_max_[t] = -emax;
   cached_size_min_[t] = dmin;
 
   // Note that we use the cached value here for EndMin()/StartMax().
@@ -303,6 +312,10 @@ void SchedulingConstraintHelper::InitSortedVectors() {
   }
 
   recompute_energy_profile_ = true;
+  recompute_by_start_min_ = true;
+  recompute_by_end_min_ = true;
+  recompute_by_start_max_ = true;
+  recompute_by_end_max_ = true;
   recompute_shifted_start_min_ = true;
   recompute_negated_shifted_end_max_ = true;
 }
@@ -323,6 +336,13 @@ void SchedulingConstraintHelper::SetTimeDirection(bool is_forward) {
     std::swap(cached_start_min_, cached_negated_end_max_);
     std::swap(cached_end_min_, cached_negated_start_max_);
     std::swap(cached_shifted_start_min_, cached_negated_shifted_end_max_);
+    // The swapped vectors still hold the times of the other direction, whose
+    // sign is the opposite of the times of this direction, so they must all be
+    // refreshed on their next access.
+    recompute_by_start_min_ = true;
+    recompute_by_end_min_ = true;
+    recompute_by_start_max_ = true;
+    recompute_by_end_max_ = true;
     std::swap(recompute_shifted_start_min_, recompute_negated_shifted_end_max_);
   }
 }
@@ -347,6 +367,8 @@ bool SchedulingConstraintHelper::SynchronizeAndSetTimeDirection(
 
 const std::vector<TaskTime>&
 SchedulingConstraintHelper::TaskByIncreasingStartMin() {
+  if (!recompute_by_start_min_) return task_by_increasing_start_min_;
+  recompute_by_start_min_ = false;
   const int num_tasks = NumTasks();
   for (int i = 0; i < num_tasks; ++i) {
     TaskTime& ref = task_by_increasing_start_min_[i];
@@ -359,6 +381,8 @@ SchedulingConstraintHelper::TaskByIncreasingStartMin() {
 
 const std::vector<TaskTime>&
 SchedulingConstraintHelper::TaskByIncreasingEndMin() {
+  if (!recompute_by_end_min_) return task_by_increasing_end_min_;
+  recompute_by_end_min_ = false;
   const int num_tasks = NumTasks();
   for (int i = 0; i < num_tasks; ++i) {
     TaskTime& ref = task_by_increasing_end_min_[i];
@@ -371,6 +395,8 @@ SchedulingConstraintHelper::TaskByIncreasingEndMin() {
 
 const std::vector<TaskTime>&
 SchedulingConstraintHelper::TaskByDecreasingStartMax() {
+  if (!recompute_by_start_max_) return task_by_decreasing_start_max_;
+  recompute_by_start_max_ = false;
   const int num_tasks = NumTasks();
   for (int i = 0; i < num_tasks; ++i) {
     TaskTime& ref = task_by_decreasing_start_max_[i];
@@ -384,6 +410,8 @@ SchedulingConstraintHelper::TaskByDecreasingStartMax() {
 
 const std::vector<TaskTime>&
 SchedulingConstraintHelper::TaskByDecreasingEndMax() {
+  if (!recompute_by_end_max_) return task_by_decreasing_end_max_;
+  recompute_by_end_max_ = false;
   const int num_tasks = NumTasks();
   for (int i = 0; i < num_tasks; ++i) {
     TaskTime& ref = task_by_decreasing_end_max_[i];
@@ -448,8 +476,13 @@ void SchedulingConstraintHelper::AddReasonForBeingBefore(int before,
 
   // The reason will be a linear expression greater than a value. Note that all
   // coeff must be positive, and we will use the variable lower bound.
-  std::vector<IntegerVariable> vars;
-  std::vector<IntegerValue> coeffs;
+  //
+  // This is called a lot by the disjunctive propagators, so we reuse our
+  // buffers instead of allocating new vectors each time.
+  std::vector<IntegerVariable>& vars = tmp_reason_vars_;
+  std::vector<IntegerValue>& coeffs = tmp_reason_coeffs_;
+  vars.clear();
+  coeffs.clear();
 
   // Reason for StartMax(before).
   const IntegerValue smax_before = StartMax(before);
@@ -469,6 +469,14 @@ class SchedulingConstraintHelper : public PropagatorInterface,
   std::vector<TaskTime> task_by_decreasing_start_max_;
   std::vector<TaskTime> task_by_decreasing_end_max_;
 
+  // Set by UpdateCachedValues() when the corresponding cached value of a task
+  // changed. When false, the sorted vector above is still valid and the
+  // TasksBy*() functions do not need to refresh and sort it again.
+  bool recompute_by_start_min_ = true;
+  bool recompute_by_end_min_ = true;
+  bool recompute_by_start_max_ = true;
+  bool recompute_by_end_max_ = true;
+
   // Sorted vector returned by GetEnergyProfile().
   bool recompute_energy_profile_ = true;
   std::vector<ProfileEvent> energy_profile_;
@@ -489,6 +497,10 @@ class SchedulingConstraintHelper : public PropagatorInterface,
   std::vector<Literal> literal_reason_;
   std::vector<IntegerLiteral> integer_reason_;
 
+  // Temporary linear expression used by AddReasonForBeingBefore().
+  std::vector<IntegerVariable> tmp_reason_vars_;
+  std::vector<IntegerValue> tmp_reason_coeffs_;
+
   // Optional 'proxy' helper used in the diffn constraint.
   SchedulingConstraintHelper* other_helper_ = nullptr;
   absl::Span<const int> map_to_other_helper_;
@@ -56,6 +56,8 @@ LbTreeSearch::LbTreeSearch(Model* model)
       shared_response_(model->GetOrCreate<SharedResponseManager>()),
       sat_decision_(model->GetOrCreate<SatDecisionPolicy>()),
       search_helper_(model->GetOrCreate<IntegerSearchHelper>()),
+      shared_tree_(model->Mutable<SharedLbTreeManager>()),
+      mapping_(model->GetOrCreate<CpModelMapping>()),
       parameters_(*model->GetOrCreate<SatParameters>()) {
   // We should create this class only in the presence of an objective.
   //
@@ -166,10 +168,35 @@ void LbTreeSearch::DebugDisplayTree(NodeIndex root) const {
 bool LbTreeSearch::FullRestart() {
   ++num_full_restarts_;
   num_decisions_taken_at_last_restart_ = num_decisions_taken_;
+  ClearTree();
+  return sat_solver_->RestoreSolverToAssumptionLevel();
+}
+
+void LbTreeSearch::ClearTree() {
   num_nodes_in_tree_ = 0;
   nodes_.clear();
   current_branch_.clear();
-  return sat_solver_->RestoreSolverToAssumptionLevel();
+}
+
+int LbTreeSearch::TreeLevel() const {
+  return sat_solver_->CurrentDecisionLevel() - sat_solver_->AssumptionLevel();
+}
+
+bool LbTreeSearch::RestoreLeafAssumptions() {
+  if (!sat_solver_->ReapplyAssumptionsIfNeeded()) return false;
+  if (TreeLevel() >= 0) return true;
+
+  // All the assumptions are fixed at level zero, so the solver ignores them
+  // and our tree levels are no longer shifted. We drop them and the tree.
+  ClearTree();
+  return sat_solver_->ResetWithGivenAssumptions({});
+}
+
+bool LbTreeSearch::ReportLeafBound(IntegerValue bound) {
+  leaf_bound_ = bound;
+  move_to_next_leaf_ = shared_tree_->UpdateLeafBound(
+      leaf_, bound, absl::StrCat("lb_tree_search ", SmallProgressString()));
+  return move_to_next_leaf_;
 }
 
 void LbTreeSearch::MarkAsDeletedNodeAndUnreachableSubtree(Node& node) {
@@ -200,11 +227,59 @@ std::string LbTreeSearch::SmallProgressString() const {
   return absl::StrCat(
       "#nodes:", num_nodes_in_tree_, "/", nodes_.size(),
       " #rc:", num_rc_detected_, " #decisions:", num_decisions_taken_,
-      " #@root:", num_back_to_root_node_, " #restarts:", num_full_restarts_);
+      " #@root:", num_back_to_root_node_, " #restarts:", num_full_restarts_,
+      shared_tree_ == nullptr
+          ? ""
+          : absl::StrCat(" #leaves:", num_leaves_explored_));
 }
 
 SatSolver::Status LbTreeSearch::Search(
     const std::function<void()>& feasible_solution_observer) {
+  if (shared_tree_ == nullptr) return SearchSubtree(feasible_solution_observer);
+
+  // We explore one leaf of the shared tree at the time, with a new tree each
+  // time since the nodes of one subtree are of no use in another.
+  while (!time_limit_->LimitReached() && !shared_response_->ProblemIsSolved()) {
+    if (leaf_ < 0 || move_to_next_leaf_) {
+      move_to_next_leaf_ = false;
+      std::vector<int> literals;
+      leaf_ = shared_tree_->AcquireLeaf(leaf_, &literals, &leaf_bound_);
+
+      // All the leaves are closed, so the problem is solved.
+      if (leaf_ < 0) break;
+
+      // Skipping a literal just makes us explore a larger subtree, so the
+      // bound we report for the leaf stays valid.
+      std::vector<Literal> assumptions;
+      for (const int ref : literals) {
+        if (mapping_->IsBoolean(ref)) {
+          assumptions.push_back(mapping_->Literal(ref));
+        }
+      }
+      ++num_leaves_explored_;
+      ClearTree();
+      if (!sat_solver_->ResetWithGivenAssumptions(assumptions)) {
+        if (sat_solver_->IsModelUnsat()) return SatSolver::INFEASIBLE;
+        ReportLeafBound(kMaxIntegerValue);
+        move_to_next_leaf_ = true;
+        continue;
+      }
+    }
+
+    const SatSolver::Status status =
+        SearchSubtree(feasible_solution_observer);
+    if (status == SatSolver::ASSUMPTIONS_UNSAT) {
+      ReportLeafBound(kMaxIntegerValue);
+      move_to_next_leaf_ = true;
+      continue;
+    }
+    if (!move_to_next_leaf_) return status;
+  }
+  return SatSolver::LIMIT_REACHED;
+}
+
+SatSolver::Status LbTreeSearch::SearchSubtree(
+    const std::function<void()>& feasible_solution_observer) {
   if (!sat_solver_->RestoreSolverToAssumptionLevel()) {
     return sat_solver_->UnsatStatus();
   }
@@ -232,11 +307,30 @@ SatSolver::Status LbTreeSearch::Search(
   const int64_t kNumDecisionsBeforeInitialRestarts = 1000;
 
   while (!time_limit_->LimitReached() && !shared_response_->ProblemIsSolved()) {
+    // A conflict might have backjumped over the leaf assumptions.
+    if (shared_tree_ != nullptr && !RestoreLeafAssumptions()) {
+      return sat_solver_->UnsatStatus();
+    }
+
     // This is the current bound we try to improve. We cache it here to avoid
     // getting the lock many times and it is also easier to follow the code if
     // this is assumed constant for one iteration.
     current_objective_lb_ = shared_response_->GetInnerObjectiveLowerBound();
 
+    // In shared tree mode, we improve the bound of our leaf, which is at least
+    // the objective lower bound at the root of our subtree.
+    if (shared_tree_ != nullptr) {
+      current_objective_lb_ = std::max(current_objective_lb_, leaf_bound_);
+      if (TreeLevel() == 0) {
+        current_objective_lb_ = std::max(
+            current_objective_lb_, integer_trail_->LowerBound(objective_var_));
+      }
+      if (current_objective_lb_ > leaf_bound_ &&
+          ReportLeafBound(current_objective_lb_)) {
+        return SatSolver::LIMIT_REACHED;
+      }
+    }
+
     // If some branches already have a good lower bound, no need to call the LP
     // on those.
     watcher_->SetStopPropagationCallback([this] {
@@ -248,7 +342,7 @@ SatSolver::Status LbTreeSearch::Search(
       // Our branch is always greater or equal to the level.
       // We increase the objective_lb of the current node if needed.
       {
-        const int current_level = sat_solver_->CurrentDecisionLevel();
+        const int current_level = TreeLevel();
         CHECK_GE(current_branch_.size(), current_level);
         for (int i = 0; i < current_level; ++i) {
           CHECK(sat_solver_->Assignment().LiteralIsAssigned(
@@ -276,7 +370,8 @@ SatSolver::Status LbTreeSearch::Search(
           for (const Literal l : reason) {
             max_level = std::max<int>(
                 max_level,
-                sat_solver_->LiteralTrail().Info(l.Variable()).level);
+                sat_solver_->LiteralTrail().Info(l.Variable()).level -
+                    sat_solver_->AssumptionLevel());
           }
           if (max_level < current_level) {
             nodes_[current_branch_[max_level]].UpdateObjective(
@@ -297,9 +392,13 @@ SatSolver::Status LbTreeSearch::Search(
       // If the root lb increased, update global shared objective lb.
       const IntegerValue bound = nodes_[current_branch_[0]].MinObjective();
       if (bound > current_objective_lb_) {
-        shared_response_->UpdateInnerObjectiveBounds(
-            absl::StrCat("lb_tree_search ", SmallProgressString()), bound,
-            integer_trail_->LevelZeroUpperBound(objective_var_));
+        if (shared_tree_ == nullptr) {
+          shared_response_->UpdateInnerObjectiveBounds(
+              absl::StrCat("lb_tree_search ", SmallProgressString()), bound,
+              integer_trail_->LevelZeroUpperBound(objective_var_));
+        } else if (ReportLeafBound(bound)) {
+          return SatSolver::LIMIT_REACHED;
+        }
         current_objective_lb_ = bound;
         if (VLOG_IS_ON(3)) DebugDisplayTree(current_branch_[0]);
       }
@@ -343,7 +442,7 @@ SatSolver::Status LbTreeSearch::Search(
     //
     // TODO(user): If we remember how far we can backjump for both true/false
     // branch, we could be more efficient.
-    while (current_branch_.size() > sat_solver_->CurrentDecisionLevel() + 1 ||
+    while (current_branch_.size() > TreeLevel() + 1 ||
            (current_branch_.size() > 1 &&
             nodes_[current_branch_.back()].MinObjective() >
                 current_objective_lb_)) {
@@ -353,6 +452,7 @@ SatSolver::Status LbTreeSearch::Search(
     // Backtrack the solver.
     {
       int backtrack_level =
+          sat_solver_->AssumptionLevel() +
           std::max(0, static_cast<int>(current_branch_.size()) - 1);
 
       // Periodic backtrack to level zero so we can import bounds.
@@ -376,6 +476,9 @@ SatSolver::Status LbTreeSearch::Search(
     if (!search_helper_->BeforeTakingDecision()) {
       return sat_solver_->UnsatStatus();
     }
+    if (shared_tree_ != nullptr && !RestoreLeafAssumptions()) {
+      return sat_solver_->UnsatStatus();
+    }
 
     // If the search has not just been restarted (in which case nodes_ would be
     // empty), and if we are at level zero (either naturally, or if the
@@ -383,11 +486,11 @@ SatSolver::Status LbTreeSearch::Search(
     // heuristic to decide whether to restart the search from scratch or not.
     //
     // We ignore small search trees.
-    if (sat_solver_->CurrentDecisionLevel() == 0 && num_nodes_in_tree_ > 50) {
+    if (TreeLevel() == 0 && num_nodes_in_tree_ > 50) {
       // Let's count how many nodes have worse objective bounds than the best
       // known external objective lower bound.
-      const IntegerValue latest_lb =
-          shared_response_->GetInnerObjectiveLowerBound();
+      const IntegerValue latest_lb = std::max(
+          shared_response_->GetInnerObjectiveLowerBound(), leaf_bound_);
       int num_nodes = 0;
       int num_nodes_with_lower_objective = 0;
       for (const Node& node : nodes_) {
@@ -411,9 +514,9 @@ SatSolver::Status LbTreeSearch::Search(
     // TODO(user): If we have new information and our current objective bound
     // is higher than any bound in a whole subtree, we might want to just
     // restart this subtree exploration?
-    while (current_branch_.size() == sat_solver_->CurrentDecisionLevel() + 1) {
+    while (current_branch_.size() == TreeLevel() + 1) {
       const int level = current_branch_.size() - 1;
-      CHECK_EQ(level, sat_solver_->CurrentDecisionLevel());
+      CHECK_EQ(level, TreeLevel());
       Node& node = nodes_[current_branch_[level]];
       node.UpdateObjective(std::max(
           current_objective_lb_, integer_trail_->LowerBound(objective_var_)));
@@ -471,7 +574,7 @@ SatSolver::Status LbTreeSearch::Search(
         }
 
         // Conflict?
-        if (current_branch_.size() != sat_solver_->CurrentDecisionLevel()) {
+        if (current_branch_.size() != TreeLevel()) {
           if (choose_true) {
             node.UpdateTrueObjective(kMaxIntegerValue);
           } else {
@@ -503,7 +606,7 @@ SatSolver::Status LbTreeSearch::Search(
     }
 
     // If a conflict occurred, we will backtrack.
-    if (current_branch_.size() != sat_solver_->CurrentDecisionLevel()) {
+    if (current_branch_.size() != TreeLevel()) {
       continue;
     }
 
@@ -533,7 +636,7 @@ SatSolver::Status LbTreeSearch::Search(
     //
     // TODO(user): In multithread, this change the behavior a lot since we
     // dive until we beat the best shared bound. Maybe we shouldn't do that.
-    const int base_level = sat_solver_->CurrentDecisionLevel();
+    const int base_level = TreeLevel();
     while (true) {
       // TODO(user): We sometimes branch on the objective variable, this should
       // probably be avoided.
@@ -551,12 +654,12 @@ SatSolver::Status LbTreeSearch::Search(
       if (!search_helper_->TakeDecision(Literal(decision))) {
         return sat_solver_->UnsatStatus();
       }
-      if (sat_solver_->CurrentDecisionLevel() < base_level) break;
+      if (TreeLevel() < base_level) break;
       if (integer_trail_->LowerBound(objective_var_) > current_objective_lb_) {
         break;
       }
     }
-    if (sat_solver_->CurrentDecisionLevel() <= base_level) continue;
+    if (TreeLevel() <= base_level) continue;
 
     // Analyse the reason for objective increase. Deduce a set of new nodes to
     // append to the tree.
@@ -565,7 +668,8 @@ SatSolver::Status LbTreeSearch::Search(
     const std::vector<Literal> reason =
         integer_trail_->ReasonFor(IntegerLiteral::GreaterOrEqual(
             objective_var_, integer_trail_->LowerBound(objective_var_)));
-    std::vector<Literal> decisions = ExtractDecisions(base_level, reason);
+    std::vector<Literal> decisions = ExtractDecisions(
+        sat_solver_->AssumptionLevel() + base_level, reason);
 
     // Bump activities.
     sat_decision_->BumpVariableActivities(reason);
@@ -593,15 +697,18 @@ SatSolver::Status LbTreeSearch::Search(
     // current propagation. We backtrack as little as possible.
     //
     // The decision level is the number of decision taken.
-    // Decision()[level] is the decision at that level.
+    // Decision()[level] is the decision at that level, after the ones of the
+    // assumption levels.
+    const int assumption_level = sat_solver_->AssumptionLevel();
     int backtrack_level = base_level;
-    CHECK_LE(current_branch_.size(), sat_solver_->CurrentDecisionLevel());
+    CHECK_LE(current_branch_.size(), TreeLevel());
     while (backtrack_level < current_branch_.size() &&
-           sat_solver_->Decisions()[backtrack_level].literal ==
+           sat_solver_->Decisions()[assumption_level + backtrack_level]
+                   .literal ==
                nodes_[current_branch_[backtrack_level]].literal) {
       ++backtrack_level;
     }
-    sat_solver_->Backtrack(backtrack_level);
+    sat_solver_->Backtrack(assumption_level + backtrack_level);
 
     // Update bounds with reduced costs info.
     //
@@ -25,6 +25,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/sat/cp_model_mapping.h"
 #include "ortools/sat/integer.h"
 #include "ortools/sat/integer_search.h"
 #include "ortools/sat/linear_programming_constraint.h"
@@ -54,6 +55,11 @@ namespace sat {
 // objective > current_lb. As a result, when it is UNSAT, we can bump the lower
 // bound by a bigger amount than one. We also do not completely loose everything
 // learned so far for the next iteration.
+//
+// When a SharedLbTreeManager is registered in the model, several workers share
+// the top of the tree: each one only explores the subtree below the leaf of the
+// shared tree it is currently assigned, under the leaf literals as assumptions,
+// and reports the bound of this subtree instead of the global bound.
 class LbTreeSearch {
  public:
   explicit LbTreeSearch(Model* model);
@@ -113,6 +119,28 @@ class LbTreeSearch {
   // the one at level n.
   void UpdateParentObjective(int level);
 
+  // The search loop, it explores the subtree below the current assumptions.
+  // In shared tree mode, it returns LIMIT_REACHED with move_to_next_leaf_ set
+  // when this worker should explore another leaf.
+  SatSolver::Status SearchSubtree(
+      const std::function<void()>& feasible_solution_observer);
+
+  // Returns the decision level of the solver relative to the root of our tree,
+  // that is without the level used by the leaf assumptions. This is -1 if the
+  // solver backtracked over the assumptions.
+  int TreeLevel() const;
+
+  // Reapplies the leaf assumptions if we backtracked over them. Returns false
+  // if they are not compatible with the model.
+  bool RestoreLeafAssumptions();
+
+  // Reports the bound of our subtree to the shared tree. Returns true if we
+  // should move to another leaf.
+  bool ReportLeafBound(IntegerValue bound);
+
+  // Forgets all the nodes.
+  void ClearTree();
+
   // Returns false on conflict.
   bool FullRestart();
 
@@ -147,6 +175,8 @@ class LbTreeSearch {
   SharedResponseManager* shared_response_;
   SatDecisionPolicy* sat_decision_;
   IntegerSearchHelper* search_helper_;
+  SharedLbTreeManager* shared_tree_;
+  CpModelMapping* mapping_;
   IntegerVariable objective_var_;
   const SatParameters& parameters_;
 
@@ -157,6 +187,13 @@ class LbTreeSearch {
   // We temporarily cache the shared_response_ objective lb here.
   IntegerValue current_objective_lb_;
 
+  // In shared tree mode, the leaf we are exploring and the last bound reported
+  // for it. The bound stays at kMinIntegerValue otherwise.
+  int leaf_ = -1;
+  IntegerValue leaf_bound_ = kMinIntegerValue;
+  bool move_to_next_leaf_ = false;
+  int64_t num_leaves_explored_ = 0;
+
   // Memory for all the nodes.
   int num_nodes_in_tree_ = 0;
   absl::StrongVector<NodeIndex, Node> nodes_;
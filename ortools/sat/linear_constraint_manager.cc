@@ -236,6 +236,14 @@ bool LinearConstraintManager::AddCut(
     const LinearConstraint& ct, std::string type_name,
     const absl::StrongVector<IntegerVariable, double>& lp_solution,
     std::string extra_info) {
+  if (record_cuts_only_) {
+    if (!ct.vars.empty()) {
+      recorded_cuts_.push_back(
+          {ct, std::move(type_name), std::move(extra_info)});
+    }
+    return false;
+  }
+
   ++num_add_cut_calls_;
   if (ct.vars.empty()) return false;
 
@@ -275,9 +283,22 @@ bool LinearConstraintManager::AddCut(
   num_cuts_++;
   num_deletable_constraints_++;
   type_to_num_cuts_[type_name]++;
+  if (export_cut_callback_ != nullptr) {
+    export_cut_callback_(constraint_infos_[ct_index].constraint);
+  }
   return true;
 }
 
+void LinearConstraintManager::TransferRecordedCuts(
+    const absl::StrongVector<IntegerVariable, double>& lp_solution,
+    LinearConstraintManager* manager) {
+  for (RecordedCut& recorded : recorded_cuts_) {
+    manager->AddCut(recorded.cut, std::move(recorded.type_name), lp_solution,
+                    std::move(recorded.extra_info));
+  }
+  recorded_cuts_.clear();
+}
+
 void LinearConstraintManager::PermanentlyRemoveSomeConstraints() {
   std::vector<double> deletable_constraint_counts;
   for (ConstraintIndex i(0); i < constraint_infos_.size(); ++i) {
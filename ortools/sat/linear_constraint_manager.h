@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -147,6 +148,24 @@ class LinearConstraintManager {
   // Returns statistics on the cut added.
   std::string Statistics() const;
 
+  // If set, this is called with each new cut added by AddCut(), after its
+  // simplification.
+  void SetCutExportCallback(
+      std::function<void(const LinearConstraint&)> callback) {
+    export_cut_callback_ = std::move(callback);
+  }
+
+  // If true, AddCut() only records the cuts and returns false. The recorded
+  // cuts can then be added to another manager with TransferRecordedCuts().
+  // This allows to run cut generators concurrently, each with its own
+  // recording manager, and to add their cuts in a deterministic order.
+  void SetRecordCutsOnly(bool record_cuts_only) {
+    record_cuts_only_ = record_cuts_only;
+  }
+  void TransferRecordedCuts(
+      const absl::StrongVector<IntegerVariable, double>& lp_solution,
+      LinearConstraintManager* manager);
+
  private:
   // Heuristic that decide which constraints we should remove from the current
   // LP. Note that such constraints can be added back later by the heuristic
@@ -209,6 +228,16 @@ class LinearConstraintManager {
   int64_t num_cuts_ = 0;
   int64_t num_add_cut_calls_ = 0;
   absl::btree_map<std::string, int> type_to_num_cuts_;
+  std::function<void(const LinearConstraint&)> export_cut_callback_;
+
+  // Cuts recorded by AddCut() when record_cuts_only_ is true.
+  struct RecordedCut {
+    LinearConstraint cut;
+    std::string type_name;
+    std::string extra_info;
+  };
+  bool record_cuts_only_ = false;
+  std::vector<RecordedCut> recorded_cuts_;
 
   bool objective_is_defined_ = false;
   bool objective_norm_computed_ = false;
@@ -31,10 +31,12 @@
 #include "absl/numeric/int128.h"
 #include "absl/random/distributions.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/revised_simplex.h"
 #include "ortools/glop/status.h"
@@ -173,6 +175,14 @@ ScatteredIntegerVector::GetTerms() {
 
 // TODO(user): make SatParameters singleton too, otherwise changing them after
 // a constraint was added will have no effect on this class.
+CutGeneratorThreadPool::CutGeneratorThreadPool(Model* model)
+    : pool_(std::make_unique<ThreadPool>(
+          "CutGenerators",
+          std::max(1, model->GetOrCreate<SatParameters>()
+                          ->num_cut_generator_threads()))) {
+  pool_->StartWorkers();
+}
+
 LinearProgrammingConstraint::LinearProgrammingConstraint(
     Model* model, absl::Span<const IntegerVariable> vars)
     : constraint_manager_(model),
@@ -597,6 +607,107 @@ void LinearProgrammingConstraint::AddCutGenerator(CutGenerator generator) {
   cut_generators_.push_back(std::move(generator));
 }
 
+void LinearProgrammingConstraint::SetCutsSharingCallbacks(
+    std::function<void(const LinearConstraint&)> export_cut,
+    std::function<void(std::vector<LinearConstraint>*)> import_cuts) {
+  import_cuts_ = std::move(import_cuts);
+  if (export_cut == nullptr) {
+    constraint_manager_.SetCutExportCallback(nullptr);
+    return;
+  }
+
+  // Only the cuts found at level zero are globally valid. The cuts coming from
+  // the other workers are not exported back.
+  constraint_manager_.SetCutExportCallback(
+      [this, export_cut = std::move(export_cut)](const LinearConstraint& cut) {
+        if (adding_shared_cuts_) return;
+        if (trail_->CurrentDecisionLevel() != 0) return;
+        export_cut(cut);
+      });
+}
+
+void LinearProgrammingConstraint::AddSharedCuts() {
+  tmp_shared_cuts_.clear();
+  import_cuts_(&tmp_shared_cuts_);
+  if (tmp_shared_cuts_.empty()) return;
+
+  // We only keep the most violated cuts so that a burst of cuts from the other
+  // workers does not blow up the size of our LP.
+  constexpr int kMaxNumSharedCutsPerCall = 50;
+  TopNCuts top_n_cuts(kMaxNumSharedCutsPerCall);
+  for (LinearConstraint& cut : tmp_shared_cuts_) {
+    bool all_vars_in_lp = true;
+    for (const IntegerVariable var : cut.vars) {
+      if (!mirror_lp_variable_.contains(PositiveVariable(var))) {
+        all_vars_in_lp = false;
+        break;
+      }
+    }
+    if (!all_vars_in_lp) continue;
+    top_n_cuts.AddCut(std::move(cut), "Shared", expanded_lp_solution_);
+  }
+  adding_shared_cuts_ = true;
+  top_n_cuts.TransferToManager(expanded_lp_solution_, &constraint_manager_);
+  adding_shared_cuts_ = false;
+}
+
+bool LinearProgrammingConstraint::RunCutGenerators(int level) {
+  const int num_threads = parameters_.num_cut_generator_threads();
+  concurrent_generators_.clear();
+  if (num_threads > 0) {
+    for (int i = 0; i < cut_generators_.size(); ++i) {
+      const CutGenerator& generator = cut_generators_[i];
+      if (level > 0 && generator.only_run_at_level_zero) continue;
+      if (generator.can_run_concurrently) concurrent_generators_.push_back(i);
+    }
+  }
+
+  // The generators that can run concurrently are scheduled on the thread pool,
+  // each with its own recording manager, while this thread runs the others.
+  // Note that the other threads only read the state of the model, which is not
+  // modified until they are all done.
+  const int num_concurrent_generators = concurrent_generators_.size();
+  if (num_concurrent_generators > 0 && cut_generator_pool_ == nullptr) {
+    cut_generator_pool_ = model_->GetOrCreate<CutGeneratorThreadPool>();
+  }
+  while (recording_managers_.size() < num_concurrent_generators) {
+    recording_managers_.push_back(
+        std::make_unique<LinearConstraintManager>(model_));
+    recording_managers_.back()->SetRecordCutsOnly(true);
+  }
+  concurrent_generator_results_.assign(num_concurrent_generators, true);
+  absl::BlockingCounter generators_running(num_concurrent_generators);
+  for (int i = 0; i < num_concurrent_generators; ++i) {
+    cut_generator_pool_->Schedule([&, i]() {
+      concurrent_generator_results_[i] =
+          cut_generators_[concurrent_generators_[i]].generate_cuts(
+              expanded_lp_solution_, recording_managers_[i].get());
+      generators_running.DecrementCount();
+    });
+  }
+
+  bool ok = true;
+  for (const CutGenerator& generator : cut_generators_) {
+    if (level > 0 && generator.only_run_at_level_zero) continue;
+    if (num_threads > 0 && generator.can_run_concurrently) continue;
+    if (!generator.generate_cuts(expanded_lp_solution_,
+                                 &constraint_manager_)) {
+      ok = false;
+      break;
+    }
+  }
+  generators_running.Wait();
+
+  // The recorded cuts are added in the order of the generators so that the
+  // result does not depend on the thread scheduling.
+  for (int i = 0; i < num_concurrent_generators; ++i) {
+    if (!concurrent_generator_results_[i]) ok = false;
+    recording_managers_[i]->TransferRecordedCuts(expanded_lp_solution_,
+                                                 &constraint_manager_);
+  }
+  return ok;
+}
+
 bool LinearProgrammingConstraint::IncrementalPropagate(
     const std::vector<int>& watch_indices) {
   if (!lp_solution_is_set_) {
@@ -1639,17 +1750,12 @@ bool LinearProgrammingConstraint::Propagate() {
         if (parameters_.add_mir_cuts()) AddMirCuts();
         if (parameters_.add_cg_cuts()) AddCGCuts();
         if (parameters_.add_zero_half_cuts()) AddZeroHalfCuts();
+        if (import_cuts_ != nullptr) AddSharedCuts();
       }
 
       // Try to add cuts.
       if (level == 0 || !parameters_.only_add_cuts_at_level_zero()) {
-        for (const CutGenerator& generator : cut_generators_) {
-          if (level > 0 && generator.only_run_at_level_zero) continue;
-          if (!generator.generate_cuts(expanded_lp_solution_,
-                                       &constraint_manager_)) {
-            return false;
-          }
-        }
+        if (!RunCutGenerators(level)) return false;
       }
 
       implied_bounds_processor_.IbCutPool().TransferToManager(
@@ -24,6 +24,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/glop/revised_simplex.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/lp_data_utils.h"
@@ -135,6 +136,24 @@ class ScatteredIntegerVector {
 // in integer arithmetic, so we are exact.
 class LinearProgrammingDispatcher;
 
+// Thread pool running the cut generators that can run concurrently, see
+// num_cut_generator_threads. It is shared by all the LP constraints of a model,
+// and a parallel solve registers the pool of its global model in the models of
+// all its workers, so that at most num_cut_generator_threads threads generate
+// cuts during a solve whatever the number of LPs and workers.
+class CutGeneratorThreadPool {
+ public:
+  explicit CutGeneratorThreadPool(Model* model);
+
+  // Schedules the closure on the pool. This is thread-safe.
+  void Schedule(std::function<void()> closure) {
+    pool_->Schedule(std::move(closure));
+  }
+
+ private:
+  std::unique_ptr<ThreadPool> pool_;
+};
+
 class LinearProgrammingConstraint : public PropagatorInterface,
                                     ReversibleInterface {
  public:
@@ -160,6 +179,16 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   // Register a new cut generator with this constraint.
   void AddCutGenerator(CutGenerator generator);
 
+  // Shares the cuts of this LP with other workers solving the same problem.
+  // export_cut is called with each new cut found at level zero, and
+  // import_cuts is called at level zero to get the cuts found by the other
+  // workers since its last call. Imported cuts with variables that are not in
+  // this LP are ignored, and only the most efficacious ones for the current LP
+  // solution are added.
+  void SetCutsSharingCallbacks(
+      std::function<void(const LinearConstraint&)> export_cut,
+      std::function<void(std::vector<LinearConstraint>*)> import_cuts);
+
   // Returns the LP value and reduced cost of a variable in the current
   // solution. These functions should only be called when HasSolution() is true.
   //
@@ -304,6 +333,13 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   void AddMirCuts();
   void AddZeroHalfCuts();
 
+  // Adds the best cuts returned by import_cuts_.
+  void AddSharedCuts();
+
+  // Calls generate_cuts() on the cut generators that should run at the given
+  // level. Returns false on conflict.
+  bool RunCutGenerators(int level);
+
   // Updates the bounds of the LP variables from the CP bounds.
   void UpdateBoundsOfLpVariables();
 
@@ -532,6 +568,18 @@ class LinearProgrammingConstraint : public PropagatorInterface,
 
   std::vector<CutGenerator> cut_generators_;
 
+  // Used by RunCutGenerators() when num_cut_generator_threads is positive. The
+  // recording managers are indexed by position in concurrent_generators_.
+  std::vector<int> concurrent_generators_;
+  std::vector<int> concurrent_generator_results_;
+  std::vector<std::unique_ptr<LinearConstraintManager>> recording_managers_;
+  CutGeneratorThreadPool* cut_generator_pool_ = nullptr;
+
+  // Used by AddSharedCuts().
+  std::function<void(std::vector<LinearConstraint>*)> import_cuts_;
+  std::vector<LinearConstraint> tmp_shared_cuts_;
+  bool adding_shared_cuts_ = false;
+
   // Store some statistics for HeuristicLPReducedCostAverage().
   bool compute_reduced_cost_averages_ = false;
   int num_calls_since_reduced_cost_averages_reset_ = 0;
@@ -600,6 +600,39 @@ void LinearPropagator::CanonicalizeConstraint(int id) {
   }
 }
 
+void LinearPropagator::Explain(int id, IntegerValue propagation_slack,
+                               IntegerLiteral literal_to_explain,
+                               int trail_index_of_literal,
+                               std::vector<Literal>* literals_reason,
+                               std::vector<int>* trail_indices_reason) {
+  literals_reason->clear();
+  trail_indices_reason->clear();
+  const ConstraintInfo& info = infos_[id];
+  enforcement_propagator_->AddEnforcementReason(info.enf_id, literals_reason);
+  reason_coeffs_.clear();
+
+  auto coeffs = GetCoeffs(info);
+  auto vars = GetVariables(info);
+  for (int i = 0; i < info.initial_size; ++i) {
+    const IntegerVariable var = vars[i];
+    if (PositiveVariable(var) == PositiveVariable(literal_to_explain.var)) {
+      continue;
+    }
+    const int index =
+        integer_trail_->FindTrailIndexOfVarBefore(var, trail_index_of_literal);
+    if (index >= 0) {
+      trail_indices_reason->push_back(index);
+      if (propagation_slack > 0) {
+        reason_coeffs_.push_back(coeffs[i]);
+      }
+    }
+  }
+  if (propagation_slack > 0) {
+    integer_trail_->RelaxLinearReason(propagation_slack, reason_coeffs_,
+                                      trail_indices_reason);
+  }
+}
+
 // TODO(user): template everything for the case info.all_coeffs_are_one ?
 bool LinearPropagator::PropagateOneConstraint(int id) {
   // This is here for development purpose, it is a bit too slow to check by
@@ -702,39 +735,9 @@ bool LinearPropagator::PropagateOneConstraint(int id) {
     const IntegerValue div = slack / coeff;
     const IntegerValue new_ub = integer_trail_->LowerBound(var) + div;
     const IntegerValue propagation_slack = (div + 1) * coeff - slack - 1;
-    if (!integer_trail_->Enqueue(
-            IntegerLiteral::LowerOrEqual(var, new_ub),
-            /*lazy_reason=*/[this, info, propagation_slack](
-                                IntegerLiteral i_lit, int trail_index,
-                                std::vector<Literal>* literal_reason,
-                                std::vector<int>* trail_indices_reason) {
-              literal_reason->clear();
-              trail_indices_reason->clear();
-              enforcement_propagator_->AddEnforcementReason(info.enf_id,
-                                                            literal_reason);
-              reason_coeffs_.clear();
-
-              auto coeffs = GetCoeffs(info);
-              auto vars = GetVariables(info);
-              for (int i = 0; i < info.initial_size; ++i) {
-                const IntegerVariable var = vars[i];
-                if (PositiveVariable(var) == PositiveVariable(i_lit.var)) {
-                  continue;
-                }
-                const int index =
-                    integer_trail_->FindTrailIndexOfVarBefore(var, trail_index);
-                if (index >= 0) {
-                  trail_indices_reason->push_back(index);
-                  if (propagation_slack > 0) {
-                    reason_coeffs_.push_back(coeffs[i]);
-                  }
-                }
-              }
-              if (propagation_slack > 0) {
-                integer_trail_->RelaxLinearReason(
-                    propagation_slack, reason_coeffs_, trail_indices_reason);
-              }
-            })) {
+    if (!integer_trail_->EnqueueWithLazyReason(
+            IntegerLiteral::LowerOrEqual(var, new_ub), id, propagation_slack,
+            this)) {
       return false;
     }
 
@@ -164,13 +164,22 @@ class EnforcementPropagator : SatPropagator {
 // - Lack detection and propagation of at least one of these linear is true
 //   which can be used to propagate more bound if a variable appear in all these
 //   constraint.
-class LinearPropagator : public PropagatorInterface, ReversibleInterface {
+class LinearPropagator : public PropagatorInterface,
+                         ReversibleInterface,
+                         LazyReasonInterface {
  public:
   explicit LinearPropagator(Model* model);
   ~LinearPropagator() override;
   bool Propagate() final;
   void SetLevel(int level) final;
 
+  // Explains the push of a bound by the constraint with given id. All the
+  // needed information only uses the const fields of infos_[id].
+  void Explain(int id, IntegerValue propagation_slack,
+               IntegerLiteral literal_to_explain, int trail_index_of_literal,
+               std::vector<Literal>* literals_reason,
+               std::vector<int>* trail_indices_reason) final;
+
   // Adds a new constraint to the propagator.
   void AddConstraint(absl::Span<const Literal> enforcement_literals,
                      absl::Span<const IntegerVariable> vars,
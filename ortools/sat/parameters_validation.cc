@@ -105,6 +105,9 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_NON_NEGATIVE(num_search_workers);
   TEST_NON_NEGATIVE(min_num_lns_workers);
   TEST_NON_NEGATIVE(interleave_batch_size);
+  TEST_NON_NEGATIVE(num_cut_generator_threads);
+  TEST_NON_NEGATIVE(num_presolve_probing_threads);
+  TEST_NON_NEGATIVE(independent_components_min_size);
   TEST_NON_NEGATIVE(probing_deterministic_time_limit);
   TEST_NON_NEGATIVE(presolve_probing_deterministic_time_limit);
 
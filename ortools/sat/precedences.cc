@@ -90,7 +90,7 @@ bool PrecedencesPropagator::Propagate() {
       const IntegerValue new_head_lb =
           integer_trail_->LowerBound(arc.tail_var) + ArcOffset(arc);
       if (new_head_lb > integer_trail_->LowerBound(arc.head_var)) {
-        if (!EnqueueAndCheck(arc, new_head_lb, trail_)) return false;
+        if (!EnqueueAndCheck(arc_index, new_head_lb, trail_)) return false;
       }
     }
   }
@@ -127,7 +127,7 @@ bool PrecedencesPropagator::PropagateOutgoingArcs(IntegerVariable var) {
     const IntegerValue new_head_lb =
         integer_trail_->LowerBound(arc.tail_var) + ArcOffset(arc);
     if (new_head_lb > integer_trail_->LowerBound(arc.head_var)) {
-      if (!EnqueueAndCheck(arc, new_head_lb, trail_)) return false;
+      if (!EnqueueAndCheck(arc_index, new_head_lb, trail_)) return false;
     }
   }
   return true;
@@ -606,27 +606,13 @@ IntegerValue PrecedencesPropagator::ArcOffset(const ArcInfo& arc) const {
                            : integer_trail_->LowerBound(arc.offset_var));
 }
 
-bool PrecedencesPropagator::EnqueueAndCheck(const ArcInfo& arc,
+bool PrecedencesPropagator::EnqueueAndCheck(ArcIndex arc_index,
                                             IntegerValue new_head_lb,
                                             Trail* trail) {
   ++num_pushes_;
+  const ArcInfo& arc = arcs_[arc_index];
   DCHECK_GT(new_head_lb, integer_trail_->LowerBound(arc.head_var));
 
-  // Compute the reason for new_head_lb.
-  //
-  // TODO(user): do like for clause and keep the negation of
-  // arc.presence_literals? I think we could change the integer.h API to accept
-  // true literal like for IntegerVariable, it is really confusing currently.
-  literal_reason_.clear();
-  for (const Literal l : arc.presence_literals) {
-    literal_reason_.push_back(l.Negated());
-  }
-
-  integer_reason_.clear();
-  integer_reason_.push_back(integer_trail_->LowerBoundAsLiteral(arc.tail_var));
-  AppendLowerBoundReasonIfValid(arc.offset_var, *integer_trail_,
-                                &integer_reason_);
-
   // The code works without this block since Enqueue() below can already take
   // care of conflicts. However, it is better to deal with the conflict
   // ourselves because we can be smarter about the reason this way.
@@ -636,6 +622,22 @@ bool PrecedencesPropagator::EnqueueAndCheck(const ArcInfo& arc,
   // size lower bound. Because of that, we can use the RelaxLinearReason()
   // code.
   if (new_head_lb > integer_trail_->UpperBound(arc.head_var)) {
+    // Compute the reason for new_head_lb.
+    //
+    // TODO(user): do like for clause and keep the negation of
+    // arc.presence_literals? I think we could change the integer.h API to
+    // accept true literal like for IntegerVariable, it is really confusing
+    // currently.
+    literal_reason_.clear();
+    for (const Literal l : arc.presence_literals) {
+      literal_reason_.push_back(l.Negated());
+    }
+
+    integer_reason_.clear();
+    integer_reason_.push_back(
+        integer_trail_->LowerBoundAsLiteral(arc.tail_var));
+    AppendLowerBoundReasonIfValid(arc.offset_var, *integer_trail_,
+                                  &integer_reason_);
     const IntegerValue slack =
         new_head_lb - integer_trail_->UpperBound(arc.head_var) - 1;
     integer_reason_.push_back(
@@ -658,9 +660,32 @@ bool PrecedencesPropagator::EnqueueAndCheck(const ArcInfo& arc,
     }
   }
 
-  return integer_trail_->Enqueue(
+  // The push is exactly the tail lower bound plus the offset, so there is no
+  // slack to relax the reason with.
+  return integer_trail_->EnqueueWithLazyReason(
       IntegerLiteral::GreaterOrEqual(arc.head_var, new_head_lb),
-      literal_reason_, integer_reason_);
+      arc_index.value(), /*propagation_slack=*/IntegerValue(0), this);
+}
+
+void PrecedencesPropagator::Explain(int id, IntegerValue /*propagation_slack*/,
+                                    IntegerLiteral /*literal_to_explain*/,
+                                    int trail_index_of_literal,
+                                    std::vector<Literal>* literals_reason,
+                                    std::vector<int>* trail_indices_reason) {
+  const ArcInfo& arc = arcs_[ArcIndex(id)];
+  literals_reason->clear();
+  for (const Literal l : arc.presence_literals) {
+    literals_reason->push_back(l.Negated());
+  }
+  trail_indices_reason->clear();
+  const int tail_index = integer_trail_->FindTrailIndexOfVarBefore(
+      arc.tail_var, trail_index_of_literal);
+  if (tail_index >= 0) trail_indices_reason->push_back(tail_index);
+  if (arc.offset_var != kNoIntegerVariable) {
+    const int offset_index = integer_trail_->FindTrailIndexOfVarBefore(
+        arc.offset_var, trail_index_of_literal);
+    if (offset_index >= 0) trail_indices_reason->push_back(offset_index);
+  }
 }
 
 bool PrecedencesPropagator::NoPropagationLeft(const Trail& trail) const {
@@ -832,7 +857,7 @@ bool PrecedencesPropagator::BellmanFordTarjan(Trail* trail) {
       const IntegerValue candidate = tail_lb + ArcOffset(arc);
       if (candidate > integer_trail_->LowerBound(arc.head_var)) {
         if (integer_trail_->IsCurrentlyIgnored(arc.head_var)) continue;
-        if (!EnqueueAndCheck(arc, candidate, trail)) return false;
+        if (!EnqueueAndCheck(arc_index, candidate, trail)) return false;
 
         // This is the Tarjan contribution to Bellman-Ford. This code detect
         // positive cycle, and because it disassemble the subtree while doing
@@ -52,7 +52,9 @@ namespace sat {
 // the form a*X + b*Y + c*Z >= rhs (or <=). Do that since this class should be
 // a lot faster at propagating small linear inequality than the generic
 // propagator and the overhead of supporting coefficient should not be too bad.
-class PrecedencesPropagator : public SatPropagator, PropagatorInterface {
+class PrecedencesPropagator : public SatPropagator,
+                              PropagatorInterface,
+                              LazyReasonInterface {
  public:
   explicit PrecedencesPropagator(Model* model)
       : SatPropagator("PrecedencesPropagator"),
@@ -71,6 +73,14 @@ class PrecedencesPropagator : public SatPropagator, PropagatorInterface {
   bool Propagate(Trail* trail) final;
   void Untrail(const Trail& trail, int trail_index) final;
 
+  // The reason of a push made on an arc, the id being the arc index. It is
+  // rebuilt from the trail: the arc presence literals and the tail (and offset)
+  // lower bounds just before the push.
+  void Explain(int id, IntegerValue propagation_slack,
+               IntegerLiteral literal_to_explain, int trail_index_of_literal,
+               std::vector<Literal>* literals_reason,
+               std::vector<int>* trail_indices_reason) final;
+
   // Propagates all the outgoing arcs of the given variable (and only those). It
   // is more efficient to do all these propagation in one go by calling
   // Propagate(), but for scheduling problem, we wants to propagate right away
@@ -210,8 +220,9 @@ class PrecedencesPropagator : public SatPropagator, PropagatorInterface {
               absl::Span<const Literal> presence_literals);
 
   // Enqueue a new lower bound for the variable arc.head_lb that was deduced
-  // from the current value of arc.tail_lb and the offset of this arc.
-  bool EnqueueAndCheck(const ArcInfo& arc, IntegerValue new_head_lb,
+  // from the current value of arc.tail_lb and the offset of this arc. The
+  // reason is only computed if it is needed during conflict analysis.
+  bool EnqueueAndCheck(ArcIndex arc_index, IntegerValue new_head_lb,
                        Trail* trail);
   IntegerValue ArcOffset(const ArcInfo& arc) const;
 
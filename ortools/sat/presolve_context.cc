@@ -2082,7 +2082,9 @@ bool LoadModelForProbing(PresolveContext* context, Model* local_model) {
   // TODO(user): Maybe do not load slow to propagate constraints? for instance
   // we do not use any linear relaxation here.
   Model model;
-  local_model->Register<SolverLogger>(context->logger());
+  if (local_model->Get<SolverLogger>() == nullptr) {
+    local_model->Register<SolverLogger>(context->logger());
+  }
 
   // Adapt some of the parameters during this probing phase.
   auto* local_param = local_model->GetOrCreate<SatParameters>();
@@ -2091,7 +2093,9 @@ bool LoadModelForProbing(PresolveContext* context, Model* local_model) {
 
   local_model->GetOrCreate<TimeLimit>()->MergeWithGlobalTimeLimit(
       context->time_limit());
-  local_model->Register<ModelRandomGenerator>(context->random());
+  if (local_model->Get<ModelRandomGenerator>() == nullptr) {
+    local_model->Register<ModelRandomGenerator>(context->random());
+  }
   auto* encoder = local_model->GetOrCreate<IntegerEncoder>();
   encoder->DisableImplicationBetweenLiteral();
   auto* mapping = local_model->GetOrCreate<CpModelMapping>();
@@ -700,6 +700,10 @@ class PresolveContext {
 
 // Utility function to load the current problem into a in-memory representation
 // that will be used for probing. Returns false if UNSAT.
+//
+// The local model uses the logger and the random generator of the context,
+// unless it already has its own, which is needed to probe it in another
+// thread.
 bool LoadModelForProbing(PresolveContext* context, Model* local_model);
 
 }  // namespace sat
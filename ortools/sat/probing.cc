@@ -116,6 +116,9 @@ bool Prober::ProbeOneVariableInternal(BooleanVariable b) {
     if (!sat_solver_->FinishPropagation()) return false;
     num_new_binary_ += new_binary_clauses_.size();
     for (auto binary : new_binary_clauses_) {
+      if (new_binary_clause_callback_ != nullptr) {
+        new_binary_clause_callback_(binary.first, binary.second);
+      }
       sat_solver_->AddBinaryClause(binary.first, binary.second);
     }
     new_binary_clauses_.clear();
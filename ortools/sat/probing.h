@@ -94,6 +94,12 @@ class Prober {
     callback_ = f;
   }
 
+  // Register a callback that will be called on each new binary clause found
+  // by ProbeBooleanVariables(), just before it is added to the SatSolver.
+  void SetNewBinaryClauseCallback(std::function<void(Literal, Literal)> f) {
+    new_binary_clause_callback_ = f;
+  }
+
  private:
   bool ProbeOneVariableInternal(BooleanVariable b);
 
@@ -124,6 +130,7 @@ class Prober {
   int num_new_literals_fixed_ = 0;
 
   std::function<void(Literal decision)> callback_ = nullptr;
+  std::function<void(Literal, Literal)> new_binary_clause_callback_ = nullptr;
 
   // Logger.
   SolverLogger* logger_;
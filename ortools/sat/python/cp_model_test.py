@@ -14,6 +14,7 @@
 """Tests for ortools.sat.python.cp_model."""
 
 from absl.testing import absltest
+from ortools.sat import sat_parameters_pb2
 from ortools.sat.python import cp_model
 
 
@@ -74,6 +75,32 @@ class LogToString(object):
         return self.__log
 
 
+def AddAssignmentProblem(model, num_items, num_bins, capacity, seed):
+    """Adds a generalized assignment problem and returns its cost."""
+    costs = []
+    loads = [[] for _ in range(num_bins)]
+    for i in range(num_items):
+        literals = []
+        for b in range(num_bins):
+            x = model.NewBoolVar('x_%i_%i_%i' % (seed, i, b))
+            literals.append(x)
+            costs.append(((7 * i + 11 * b * b + 5 * seed + 3) % 19 + 1) * x)
+            loads[b].append(((5 * i + 3 * b + 2 * seed) % 9 + 2) * x)
+        model.AddExactlyOne(literals)
+    for load in loads:
+        model.Add(sum(load) <= capacity)
+    return sum(costs)
+
+
+def SolveWithParameters(model, **parameters):
+    """Solves the model and returns the status and the objective value."""
+    solver = cp_model.CpSolver()
+    for name, value in parameters.items():
+        setattr(solver.parameters, name, value)
+    status = solver.Solve(model)
+    return status, solver.ObjectiveValue()
+
+
 class CpModelTest(absltest.TestCase):
 
     def testCreateIntegerVariable(self):
@@ -1408,6 +1435,201 @@ class CpModelTest(absltest.TestCase):
         self.assertEqual(solver.SolutionInfo(),
                          'var #0 has no domain(): name: "x0"')
 
+    def testJobShopWithBothTimeDirections(self):
+        print('testJobShopWithBothTimeDirections')
+        # Fisher and Thompson 6x6 instance (ft06), whose optimal makespan is
+        # 55. The disjunctive propagators share one scheduling helper per
+        # machine and flip its time direction at each propagation, so the
+        # sorted task lists must be refreshed after each flip.
+        jobs = [[(2, 1), (0, 3), (1, 6), (3, 7), (5, 3), (4, 6)],
+                [(1, 8), (2, 5), (4, 10), (5, 10), (0, 10), (3, 4)],
+                [(2, 5), (3, 4), (5, 8), (0, 9), (1, 1), (4, 7)],
+                [(1, 5), (0, 5), (2, 5), (3, 3), (4, 8), (5, 9)],
+                [(2, 9), (1, 3), (4, 5), (5, 4), (0, 3), (3, 1)],
+                [(1, 3), (3, 3), (5, 9), (0, 10), (4, 4), (2, 1)]]
+        horizon = sum(duration for job in jobs for _, duration in job)
+        model = cp_model.CpModel()
+        intervals_per_machine = [[] for _ in range(6)]
+        makespan = model.NewIntVar(0, horizon, 'makespan')
+        for job_id, job in enumerate(jobs):
+            previous_end = None
+            for task_id, (machine, duration) in enumerate(job):
+                suffix = '_%i_%i' % (job_id, task_id)
+                start = model.NewIntVar(0, horizon, 'start' + suffix)
+                end = model.NewIntVar(0, horizon, 'end' + suffix)
+                intervals_per_machine[machine].append(
+                    model.NewIntervalVar(start, duration, end,
+                                         'interval' + suffix))
+                if previous_end is not None:
+                    model.Add(start >= previous_end)
+                previous_end = end
+            model.Add(makespan >= previous_end)
+        for intervals in intervals_per_machine:
+            model.AddNoOverlap(intervals)
+        model.Minimize(makespan)
+
+        solver = cp_model.CpSolver()
+        solver.parameters.num_workers = 1
+        self.assertEqual(cp_model.OPTIMAL, solver.Solve(model))
+        self.assertEqual(55, solver.ObjectiveValue())
+
+    def testShareLinearCuts(self):
+        print('testShareLinearCuts')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 10, 3, 16, 0))
+        for parameters in [{}, {'share_linear_cuts': True}]:
+            status, objective = SolveWithParameters(model,
+                                                    num_workers=8,
+                                                    linearization_level=2,
+                                                    **parameters)
+            self.assertEqual(cp_model.OPTIMAL, status)
+            self.assertEqual(83, objective)
+
+    def testNumCutGeneratorThreads(self):
+        print('testNumCutGeneratorThreads')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 10, 3, 16, 1))
+        for num_workers in [1, 8]:
+            for num_threads in [0, 2]:
+                status, objective = SolveWithParameters(
+                    model,
+                    num_workers=num_workers,
+                    linearization_level=2,
+                    num_cut_generator_threads=num_threads)
+                self.assertEqual(cp_model.OPTIMAL, status)
+                self.assertEqual(68, objective)
+
+    def testLnsUsePersistentModels(self):
+        print('testLnsUsePersistentModels')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 20, 4, 26, 0))
+        default_status, default_objective = SolveWithParameters(model,
+                                                                num_workers=8)
+        status, objective = SolveWithParameters(model,
+                                                num_workers=8,
+                                                lns_use_persistent_models=True)
+        self.assertEqual(cp_model.OPTIMAL, default_status)
+        self.assertEqual(default_status, status)
+        self.assertEqual(default_objective, objective)
+
+    def testNumPresolveProbingThreads(self):
+        print('testNumPresolveProbingThreads')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 10, 3, 16, 2))
+        for num_threads in [0, 3]:
+            status, objective = SolveWithParameters(
+                model, num_workers=1, num_presolve_probing_threads=num_threads)
+            self.assertEqual(cp_model.OPTIMAL, status)
+            self.assertEqual(61, objective)
+
+    def testUseCompactBinaryImplications(self):
+        print('testUseCompactBinaryImplications')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 10, 3, 16, 0))
+        parameters = sat_parameters_pb2.SatParameters
+        for algorithm in [
+                parameters.BINARY_MINIMIZATION_FIRST,
+                parameters.BINARY_MINIMIZATION_FIRST_WITH_TRANSITIVE_REDUCTION
+        ]:
+            for use_compact in [False, True]:
+                status, objective = SolveWithParameters(
+                    model,
+                    num_workers=1,
+                    binary_minimization_algorithm=algorithm,
+                    use_compact_binary_implications=use_compact)
+                self.assertEqual(cp_model.OPTIMAL, status)
+                self.assertEqual(83, objective)
+
+    def testShareLbTreeSearchTree(self):
+        print('testShareLbTreeSearchTree')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 10, 3, 16, 1))
+        for share_tree in [False, True]:
+            solver = cp_model.CpSolver()
+            solver.parameters.num_workers = 5
+            solver.parameters.subsolvers.extend(
+                ['lb_tree_search', 'lb_tree_search', 'default_lp'])
+            solver.parameters.share_lb_tree_search_tree = share_tree
+            self.assertEqual(cp_model.OPTIMAL, solver.Solve(model))
+            self.assertEqual(68, solver.ObjectiveValue())
+            self.assertEqual(68, solver.BestObjectiveBound())
+
+    def testOptionalTasksWithConditionalPrecedences(self):
+        print('testOptionalTasksWithConditionalPrecedences')
+        # (duration, release date, deadline, reward) of optional tasks on one
+        # machine. The best subset, found by enumeration, has a reward of 15.
+        tasks = [(3, 0, 8, 4), (2, 1, 6, 3), (4, 0, 12, 5), (2, 3, 9, 2),
+                 (3, 2, 11, 4), (1, 5, 7, 1)]
+        model = cp_model.CpModel()
+        presences = []
+        starts = []
+        ends = []
+        intervals = []
+        for i, (duration, release, deadline, _) in enumerate(tasks):
+            presence = model.NewBoolVar('presence_%i' % i)
+            start = model.NewIntVar(release, deadline, 'start_%i' % i)
+            end = model.NewIntVar(release, deadline, 'end_%i' % i)
+            intervals.append(
+                model.NewOptionalIntervalVar(start, duration, end, presence,
+                                             'interval_%i' % i))
+            presences.append(presence)
+            starts.append(start)
+            ends.append(end)
+        model.AddNoOverlap(intervals)
+        # When both tasks are performed, the first one must end before the
+        # second one starts.
+        for before, after in [(0, 2), (1, 3), (2, 4)]:
+            model.Add(starts[after] >= ends[before]).OnlyEnforceIf(
+                [presences[before], presences[after]])
+        model.Maximize(
+            sum(task[3] * presence for task, presence in zip(tasks, presences)))
+
+        solver = cp_model.CpSolver()
+        solver.parameters.num_workers = 1
+        self.assertEqual(cp_model.OPTIMAL, solver.Solve(model))
+        self.assertEqual(15, solver.ObjectiveValue())
+
+    def testCrossoverAndLocalBranchingLns(self):
+        print('testCrossoverAndLocalBranchingLns')
+        model = cp_model.CpModel()
+        model.Minimize(AddAssignmentProblem(model, 20, 4, 26, 1))
+        default_status, default_objective = SolveWithParameters(model,
+                                                                num_workers=8)
+        status, objective = SolveWithParameters(
+            model, num_workers=8, use_crossover_and_local_branching_lns=True)
+        self.assertEqual(cp_model.OPTIMAL, default_status)
+        self.assertEqual(default_status, status)
+        self.assertEqual(default_objective, objective)
+
+    def testSolveIndependentComponents(self):
+        print('testSolveIndependentComponents')
+        # Three independent assignment problems, whose optimal costs were
+        # found by enumeration.
+        model = cp_model.CpModel()
+        costs = [
+            AddAssignmentProblem(model, 10, 3, 16, seed) for seed in range(3)
+        ]
+        model.Minimize(sum(costs))
+        for solve_independent_components in [False, True]:
+            solver = cp_model.CpSolver()
+            solver.parameters.num_workers = 8
+            solver.parameters.solve_independent_components = (
+                solve_independent_components)
+            self.assertEqual(cp_model.OPTIMAL, solver.Solve(model))
+            self.assertEqual(212, solver.ObjectiveValue())
+            self.assertEqual(212, solver.BestObjectiveBound())
+            self.assertEqual([83, 68, 61], [solver.Value(c) for c in costs])
+
+        # A component without solution makes the whole model infeasible: the
+        # total weight of its items is above the total capacity of its bins.
+        AddAssignmentProblem(model, 10, 3, 5, 3)
+        for solve_independent_components in [False, True]:
+            status, _ = SolveWithParameters(
+                model,
+                num_workers=8,
+                solve_independent_components=solve_independent_components)
+            self.assertEqual(cp_model.INFEASIBLE, status)
+
 
 if __name__ == '__main__':
     absltest.main()
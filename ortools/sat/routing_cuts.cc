@@ -424,6 +424,7 @@ CutGenerator CreateStronglyConnectedGraphCutGenerator(
     std::vector<Literal> literals, Model* model) {
   CutGenerator result;
   result.vars = GetAssociatedVariables(literals, model);
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [num_nodes, tails, heads, literals, model](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
@@ -444,6 +445,7 @@ CutGenerator CreateCVRPCutGenerator(int num_nodes, std::vector<int> tails,
                                     int64_t capacity, Model* model) {
   CutGenerator result;
   result.vars = GetAssociatedVariables(literals, model);
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [num_nodes, tails, heads, demands, capacity, literals, model](
           const absl::StrongVector<IntegerVariable, double>& lp_values,
@@ -616,6 +618,7 @@ CutGenerator CreateFlowCutGenerator(
   for (const AffineExpression expr : arc_capacities) {
     if (!expr.IsConstant()) result.vars.push_back(expr.var);
   }
+  result.can_run_concurrently = true;
   result.generate_cuts =
       [=](const absl::StrongVector<IntegerVariable, double>& lp_values,
           LinearConstraintManager* manager) {
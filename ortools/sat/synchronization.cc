@@ -35,6 +35,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/flags/flag.h"
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -42,6 +43,7 @@
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_utils.h"
 #include "ortools/sat/integer.h"
@@ -52,6 +54,7 @@
 #include "ortools/sat/util.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/logging.h"
+#include "ortools/util/saturated_arithmetic.h"
 #include "ortools/util/sorted_interval_list.h"
 #include "ortools/util/strong_integers.h"
 #include "ortools/util/time_limit.h"
@@ -311,9 +314,9 @@ void SharedResponseManager::UpdateInnerObjectiveBounds(
     return;
   }
 
-  const bool change =
-      (lb > inner_objective_lower_bound_ || ub < inner_objective_upper_bound_);
-  if (lb > inner_objective_lower_bound_) {
+  const bool lb_improved = lb > inner_objective_lower_bound_;
+  const bool change = lb_improved || ub < inner_objective_upper_bound_;
+  if (lb_improved) {
     // When the improving problem is infeasible, it is possible to report
     // arbitrary high inner_objective_lower_bound_. We make sure it never cross
     // the current best solution, so that we always report globablly valid lower
@@ -350,6 +353,13 @@ void SharedResponseManager::UpdateInnerObjectiveBounds(
     SOLVER_LOG(logger_, ProgressMessage("Bound", wall_timer_.Get(), best,
                                         new_lb, new_ub, update_info));
   }
+  if (lb_improved && !best_bound_callbacks_.empty()) {
+    const double best_bound =
+        ScaleObjectiveValue(*objective_or_null_, inner_objective_lower_bound_);
+    for (const auto& callback : best_bound_callbacks_) {
+      callback(best_bound);
+    }
+  }
   if (change) TestGapLimitsIfNeeded();
 }
 
@@ -461,6 +471,12 @@ void SharedResponseManager::UnregisterCallback(int callback_id) {
   LOG(DFATAL) << "Callback id " << callback_id << " not registered.";
 }
 
+void SharedResponseManager::AddBestBoundCallback(
+    std::function<void(double)> callback) {
+  absl::MutexLock mutex_lock(&mutex_);
+  best_bound_callbacks_.push_back(std::move(callback));
+}
+
 CpSolverResponse SharedResponseManager::GetResponseInternal(
     absl::Span<const int64_t> variable_values,
     const std::string& solution_info) {
@@ -706,6 +722,69 @@ void SharedResponseManager::NewSolution(
 #endif  // __PORTABLE_PLATFORM__
 }
 
+void SharedResponseManager::InitializeComponents(
+    std::vector<std::vector<int>> component_variables,
+    std::vector<IntegerValue> component_lower_bounds) {
+  CHECK_EQ(component_variables.size(), component_lower_bounds.size());
+  absl::MutexLock mutex_lock(&mutex_);
+  const int num_components = component_variables.size();
+  num_component_variables_ = 0;
+  for (const std::vector<int>& variables : component_variables) {
+    num_component_variables_ += variables.size();
+  }
+  component_variables_ = std::move(component_variables);
+  component_lower_bounds_ = std::move(component_lower_bounds);
+  component_objectives_.assign(num_components, kMaxIntegerValue);
+  component_solutions_.assign(num_components, {});
+}
+
+void SharedResponseManager::NewComponentSolution(
+    int component, IntegerValue objective, absl::Span<const int64_t> values,
+    const std::string& solution_info) {
+  std::vector<int64_t> solution;
+  {
+    absl::MutexLock mutex_lock(&mutex_);
+    CHECK_EQ(values.size(), component_variables_[component].size());
+    std::vector<int64_t>& component_solution = component_solutions_[component];
+    if (!component_solution.empty() &&
+        (objective_or_null_ == nullptr ||
+         objective >= component_objectives_[component])) {
+      return;
+    }
+    component_objectives_[component] = objective;
+    component_solution.assign(values.begin(), values.end());
+
+    for (const std::vector<int64_t>& other : component_solutions_) {
+      if (other.empty()) return;
+    }
+    solution.resize(num_component_variables_);
+    for (int c = 0; c < component_variables_.size(); ++c) {
+      const std::vector<int>& variables = component_variables_[c];
+      for (int i = 0; i < variables.size(); ++i) {
+        solution[variables[i]] = component_solutions_[c][i];
+      }
+    }
+  }
+
+  // Note that NewSolution() ignores non-improving solutions, so it is fine
+  // if two threads do this concurrently.
+  NewSolution(solution, solution_info);
+}
+
+void SharedResponseManager::UpdateComponentLowerBound(
+    int component, IntegerValue lb, const std::string& update_info) {
+  int64_t sum = 0;
+  {
+    absl::MutexLock mutex_lock(&mutex_);
+    if (lb <= component_lower_bounds_[component]) return;
+    component_lower_bounds_[component] = lb;
+    for (const IntegerValue bound : component_lower_bounds_) {
+      sum = CapAdd(sum, bound.value());
+    }
+  }
+  UpdateInnerObjectiveBounds(update_info, IntegerValue(sum), kMaxIntegerValue);
+}
+
 bool SharedResponseManager::ProblemIsSolved() const {
   absl::MutexLock mutex_lock(&mutex_);
   return synchronized_best_status_ == CpSolverStatus::OPTIMAL ||
@@ -1010,6 +1089,188 @@ void SharedClausesManager::Synchronize() {
   // TODO(user): We could cleanup added_binary_clauses_ periodically.
 }
 
+SharedCutsManager::SharedCutsManager(bool always_synchronize)
+    : always_synchronize_(always_synchronize) {}
+
+int SharedCutsManager::RegisterNewId() {
+  absl::MutexLock mutex_lock(&mutex_);
+  const int id = id_to_last_processed_cut_.size();
+  id_to_last_processed_cut_.resize(id + 1, 0);
+  id_to_cuts_exported_.resize(id + 1, 0);
+  return id;
+}
+
+void SharedCutsManager::SetWorkerNameForId(int id,
+                                           const std::string& worker_name) {
+  absl::MutexLock mutex_lock(&mutex_);
+  id_to_worker_name_[id] = worker_name;
+}
+
+void SharedCutsManager::AddCut(int id, LinearConstraintProto cut) {
+  // Canonicalize the cut so that duplicates have the same hash.
+  std::vector<std::pair<int, int64_t>> terms;
+  terms.reserve(cut.vars_size());
+  for (int i = 0; i < cut.vars_size(); ++i) {
+    DCHECK(RefIsPositive(cut.vars(i)));
+    terms.push_back({cut.vars(i), cut.coeffs(i)});
+  }
+  std::sort(terms.begin(), terms.end());
+  for (int i = 0; i < terms.size(); ++i) {
+    cut.set_vars(i, terms[i].first);
+    cut.set_coeffs(i, terms[i].second);
+  }
+  const size_t hash = absl::HashOf(absl::MakeConstSpan(cut.vars()),
+                                   absl::MakeConstSpan(cut.coeffs()),
+                                   absl::MakeConstSpan(cut.domain()));
+
+  absl::MutexLock mutex_lock(&mutex_);
+  if (!added_cuts_hashes_.insert(hash).second) return;
+  added_cuts_.push_back(std::move(cut));
+  if (always_synchronize_) ++last_visible_cut_;
+  id_to_cuts_exported_[id]++;
+  // Small optim. If the worker is already up to date with cuts to import, we
+  // can mark this new cut as already seen.
+  if (id_to_last_processed_cut_[id] == added_cuts_.size() - 1) {
+    id_to_last_processed_cut_[id]++;
+  }
+}
+
+void SharedCutsManager::GetUnseenCuts(
+    int id, std::vector<LinearConstraintProto>* new_cuts) {
+  new_cuts->clear();
+  absl::MutexLock mutex_lock(&mutex_);
+  const int last_cut_seen = id_to_last_processed_cut_[id];
+  if (last_cut_seen >= last_visible_cut_) return;
+  new_cuts->assign(added_cuts_.begin() + last_cut_seen,
+                   added_cuts_.begin() + last_visible_cut_);
+  id_to_last_processed_cut_[id] = last_visible_cut_;
+}
+
+void SharedCutsManager::LogStatistics(SolverLogger* logger) {
+  absl::MutexLock mutex_lock(&mutex_);
+  absl::btree_map<std::string, int64_t> name_to_cuts;
+  for (int id = 0; id < id_to_cuts_exported_.size(); ++id) {
+    if (id_to_cuts_exported_[id] == 0) continue;
+    name_to_cuts[id_to_worker_name_[id]] += id_to_cuts_exported_[id];
+  }
+  if (!name_to_cuts.empty()) {
+    SOLVER_LOG(logger, "");
+    SOLVER_LOG(logger, "Cuts shared per subsolver:");
+    for (const auto& entry : name_to_cuts) {
+      SOLVER_LOG(logger, "  '", entry.first, "': ", entry.second);
+    }
+  }
+}
+
+void SharedCutsManager::Synchronize() {
+  absl::MutexLock mutex_lock(&mutex_);
+  last_visible_cut_ = added_cuts_.size();
+}
+
+SharedLbTreeManager::SharedLbTreeManager(const CpModelProto& model_proto,
+                                         int num_workers,
+                                         SharedResponseManager* response)
+    : response_(response) {
+  std::vector<std::pair<int64_t, int>> candidates;
+  const CpObjectiveProto& objective = model_proto.objective();
+  for (int i = 0; i < objective.vars_size(); ++i) {
+    const int var = PositiveRef(objective.vars(i));
+    const IntegerVariableProto& var_proto = model_proto.variables(var);
+    if (var_proto.domain_size() != 2 || var_proto.domain(0) != 0 ||
+        var_proto.domain(1) != 1) {
+      continue;
+    }
+    candidates.push_back({-std::abs(objective.coeffs(i)), var});
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  int num_leaves = 1;
+  for (const auto& [unused, var] : candidates) {
+    if (num_leaves >= 2 * num_workers) break;
+    if (std::find(split_variables_.begin(), split_variables_.end(), var) !=
+        split_variables_.end()) {
+      continue;
+    }
+    split_variables_.push_back(var);
+    num_leaves *= 2;
+  }
+  num_internal_nodes_ = num_leaves - 1;
+  bounds_.assign(num_internal_nodes_ + num_leaves, kMinIntegerValue);
+  num_workers_per_leaf_.assign(num_leaves, 0);
+}
+
+int SharedLbTreeManager::AcquireLeaf(int previous_leaf,
+                                     std::vector<int>* literals,
+                                     IntegerValue* bound) {
+  const IntegerValue upper_bound = response_->GetInnerObjectiveUpperBound();
+  absl::MutexLock mutex_lock(&mutex_);
+  if (previous_leaf >= 0) --num_workers_per_leaf_[previous_leaf];
+
+  int best_leaf = -1;
+  std::pair<int, IntegerValue> best_key;
+  for (int leaf = 0; leaf < num_workers_per_leaf_.size(); ++leaf) {
+    const IntegerValue leaf_bound = bounds_[num_internal_nodes_ + leaf];
+    if (leaf_bound > upper_bound) continue;
+    const std::pair<int, IntegerValue> key = {num_workers_per_leaf_[leaf],
+                                              leaf_bound};
+    if (best_leaf == -1 || key < best_key) {
+      best_leaf = leaf;
+      best_key = key;
+    }
+  }
+  if (best_leaf == -1) return -1;
+
+  ++num_workers_per_leaf_[best_leaf];
+  *bound = bounds_[num_internal_nodes_ + best_leaf];
+  literals->clear();
+  for (int i = 0; i < split_variables_.size(); ++i) {
+    const int var = split_variables_[i];
+    literals->push_back(((best_leaf >> i) & 1) ? var : NegatedRef(var));
+  }
+  return best_leaf;
+}
+
+bool SharedLbTreeManager::UpdateLeafBound(int leaf, IntegerValue bound,
+                                          const std::string& update_info) {
+  const IntegerValue upper_bound = response_->GetInnerObjectiveUpperBound();
+  IntegerValue old_root_bound;
+  IntegerValue new_root_bound;
+  bool should_move = false;
+  {
+    absl::MutexLock mutex_lock(&mutex_);
+    old_root_bound = bounds_[0];
+    int node = num_internal_nodes_ + leaf;
+    if (bound > bounds_[node]) {
+      bounds_[node] = bound;
+
+      // The bound of a node is the minimum of the bounds of its children, we
+      // stop as soon as it does not change.
+      while (node > 0) {
+        node = (node - 1) / 2;
+        const IntegerValue min_of_children =
+            std::min(bounds_[2 * node + 1], bounds_[2 * node + 2]);
+        if (min_of_children <= bounds_[node]) break;
+        bounds_[node] = min_of_children;
+      }
+    }
+    new_root_bound = bounds_[0];
+
+    const IntegerValue leaf_bound = bounds_[num_internal_nodes_ + leaf];
+    should_move = leaf_bound > upper_bound;
+    for (int other = 0; !should_move && other < num_workers_per_leaf_.size();
+         ++other) {
+      if (num_workers_per_leaf_[other] > 0) continue;
+      should_move = bounds_[num_internal_nodes_ + other] < leaf_bound;
+    }
+  }
+
+  if (new_root_bound > old_root_bound) {
+    response_->UpdateInnerObjectiveBounds(update_info, new_root_bound,
+                                          kMaxIntegerValue);
+  }
+  return should_move;
+}
+
 void SharedStatistics::AddStats(
     absl::Span<const std::pair<std::string, int64_t>> stats) {
   absl::MutexLock mutex_lock(&mutex_);
@@ -241,6 +241,12 @@ class SharedResponseManager {
       std::function<void(const CpSolverResponse&)> callback);
   void UnregisterCallback(int callback_id);
 
+  // Adds a callback that will be called with the new best objective bound (in
+  // the scaled objective space) each time the inner objective lower bound
+  // improves. The callback is called with the class mutex held, so it must not
+  // call back into this class.
+  void AddBestBoundCallback(std::function<void(double)> callback);
+
   // The "inner" objective is the CpModelProto objective without scaling/offset.
   // Note that these bound correspond to valid bound for the problem of finding
   // a strictly better objective than the current one. Thus the lower bound is
@@ -310,6 +316,26 @@ class SharedResponseManager {
   // make the problem infeasible.
   void AddUnsatCore(const std::vector<int>& core);
 
+  // Support for solving a model made of independent components separately.
+  // The variables of the model are partitioned so that component_variables[c]
+  // are the ones of the component c, and the objective terms of a component
+  // only involve its variables. The part of the inner objective of c is
+  // initially known to be >= component_lower_bounds[c].
+  void InitializeComponents(std::vector<std::vector<int>> component_variables,
+                            std::vector<IntegerValue> component_lower_bounds);
+
+  // Reports a solution of a component, the values being in the order of its
+  // variables. Each time all the components have a solution, their best ones
+  // are combined into a full solution that is given to NewSolution().
+  void NewComponentSolution(int component, IntegerValue objective,
+                            absl::Span<const int64_t> values,
+                            const std::string& solution_info);
+
+  // Reports a new lower bound on the objective part of a component. The sum of
+  // the component bounds is then a lower bound on the full inner objective.
+  void UpdateComponentLowerBound(int component, IntegerValue lb,
+                                 const std::string& update_info);
+
   // Returns true if we found the optimal solution or the problem was proven
   // infeasible. Note that if the gap limit is reached, we will also report
   // OPTIMAL and consider the problem solved.
@@ -408,6 +434,17 @@ class SharedResponseManager {
   int next_callback_id_ ABSL_GUARDED_BY(mutex_) = 0;
   std::vector<std::pair<int, std::function<void(const CpSolverResponse&)>>>
       callbacks_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::function<void(double)>> best_bound_callbacks_
+      ABSL_GUARDED_BY(mutex_);
+
+  // The components of the model, see InitializeComponents(). An empty solution
+  // means that the component has no solution yet.
+  int num_component_variables_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::vector<std::vector<int>> component_variables_ ABSL_GUARDED_BY(mutex_);
+  std::vector<IntegerValue> component_lower_bounds_ ABSL_GUARDED_BY(mutex_);
+  std::vector<IntegerValue> component_objectives_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::vector<int64_t>> component_solutions_
+      ABSL_GUARDED_BY(mutex_);
 
   std::vector<std::function<void(std::vector<int64_t>*)>>
       solution_postprocessors_ ABSL_GUARDED_BY(mutex_);
@@ -549,6 +586,112 @@ class SharedClausesManager {
   absl::flat_hash_map<int, std::string> id_to_worker_name_;
 };
 
+// This class holds the linear cuts found by the workers at level zero so that
+// they do not need to be separated again by the other workers.
+//
+// It is thread-safe.
+//
+// Note that the cuts are expressed on the variables of the cp_model.proto:
+// vars are positive references sorted in increasing order and the domain
+// contains the lower and upper bound of the cut.
+class SharedCutsManager {
+ public:
+  explicit SharedCutsManager(bool always_synchronize);
+
+  // Adds a cut, duplicates are ignored. The terms of the cut do not need to be
+  // sorted.
+  void AddCut(int id, LinearConstraintProto cut);
+
+  // Fills new_cuts with the cuts added by all ids since the last call with the
+  // same id.
+  void GetUnseenCuts(int id, std::vector<LinearConstraintProto>* new_cuts);
+
+  // Ids are used to identify which worker is exporting/importing cuts.
+  int RegisterNewId();
+  void SetWorkerNameForId(int id, const std::string& worker_name);
+
+  // Search statistics.
+  void LogStatistics(SolverLogger* logger);
+
+  // Unlocks waiting cuts for workers if always_synchronize is false.
+  void Synchronize();
+
+ private:
+  absl::Mutex mutex_;
+  // Cache to avoid adding the same cut twice.
+  absl::flat_hash_set<size_t> added_cuts_hashes_ ABSL_GUARDED_BY(mutex_);
+  std::vector<LinearConstraintProto> added_cuts_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int> id_to_last_processed_cut_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int64_t> id_to_cuts_exported_ ABSL_GUARDED_BY(mutex_);
+  int last_visible_cut_ ABSL_GUARDED_BY(mutex_) = 0;
+  const bool always_synchronize_ = true;
+
+  // Used for reporting statistics.
+  absl::flat_hash_map<int, std::string> id_to_worker_name_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+// Shares the top of the search tree between several lb_tree_search workers.
+//
+// The first levels of this tree branch on a few Boolean variables of the
+// objective, so each leaf corresponds to one assignment of these variables.
+// A worker explores the subtree below one leaf at the time under the leaf
+// literals as assumptions, and reports the objective lower bound it proves
+// for this subtree. The bounds are propagated up to the root, whose bound is
+// a valid lower bound for the whole problem and is pushed to the
+// SharedResponseManager.
+//
+// It is thread-safe. The tree is small (a few times the number of workers) so
+// each call only holds the lock for a short time.
+//
+// Note that the leaves are expressed with literals as encoded in the
+// cp_model.proto.
+class SharedLbTreeManager {
+ public:
+  // The split variables are chosen among the Boolean variables of the
+  // objective with largest coefficient magnitude, with enough of them to have
+  // at least two leaves per worker. Check NumLeaves() > 1 to see if there was
+  // something to split on.
+  SharedLbTreeManager(const CpModelProto& model_proto, int num_workers,
+                      SharedResponseManager* response);
+
+  int NumLeaves() const { return num_internal_nodes_ + 1; }
+
+  // Releases previous_leaf (if not negative) and assigns a new leaf to the
+  // caller: among the leaves that may still improve the objective, one
+  // explored by the fewest workers and then with the lowest bound. Fills its
+  // literals and its current bound, and returns its index, or -1 if all the
+  // leaves are closed.
+  int AcquireLeaf(int previous_leaf, std::vector<int>* literals,
+                  IntegerValue* bound);
+
+  // Records that the objective is at least bound in the given leaf, use
+  // kMaxIntegerValue for an infeasible leaf. Returns true if the caller should
+  // move to another leaf, that is if the leaf is closed or if there is a leaf
+  // with a lower bound that no worker is exploring. The update_info is used in
+  // the logs when the root bound improves.
+  bool UpdateLeafBound(int leaf, IntegerValue bound,
+                       const std::string& update_info);
+
+ private:
+  SharedResponseManager* response_;
+
+  // Proto variables assigned on each level of the tree.
+  std::vector<int> split_variables_;
+
+  absl::Mutex mutex_;
+
+  // Complete binary tree stored as a heap: the children of node n are 2n + 1
+  // and 2n + 2, and the leaves are the last nodes. The leaf l of index
+  // num_internal_nodes_ + l fixes split_variables_[i] to the i-th bit of l.
+  // A leaf is closed once its bound is greater than the objective upper bound.
+  int num_internal_nodes_ = 0;
+  std::vector<IntegerValue> bounds_ ABSL_GUARDED_BY(mutex_);
+
+  // Number of workers currently exploring each leaf.
+  std::vector<int> num_workers_per_leaf_ ABSL_GUARDED_BY(mutex_);
+};
+
 // Simple class to add statistics by name and print them at the end.
 class SharedStatistics {
  public: